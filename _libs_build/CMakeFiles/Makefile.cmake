@@ -0,0 +1,95 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/libs/CMakeLists.txt"
+  "/root/repo/libs/algorithms/CMakeLists.txt"
+  "/root/repo/libs/bench/CMakeLists.txt"
+  "/root/repo/libs/data_structures/CMakeLists.txt"
+  "/root/repo/libs/test/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceRuns.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "algorithms/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "data_structures/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "bench/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "test/CMakeFiles/hash_table_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/linked_list_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/array_list_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/insertion_sort_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/merge_sort_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/heap_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/bubble_sort_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/heap_sort_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/quick_sort_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/priority_queue_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/indexed_priority_queue_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/radix_heap_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/undirected_graph_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/directed_graph_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_aco_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_anneal_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_async_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_bound_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_cluster_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_cache_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_resolve_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_small_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/tsp_transposition_table_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/thread_pool_test.dir/DependInfo.cmake"
+  "test/CMakeFiles/undirected_graph_avx2_test.dir/DependInfo.cmake"
+  "bench/CMakeFiles/array_list_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/hash_table_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/linked_list_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/binary_search_tree_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/priority_queue_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/sort_bench.dir/DependInfo.cmake"
+  "bench/CMakeFiles/bench.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,60 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libs
+# Build directory: /root/repo/_libs_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ArrayListTest "/root/repo/_libs_build/test/array_list_test")
+set_tests_properties(ArrayListTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;20;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(InsertionSortTest "/root/repo/_libs_build/test/insertion_sort_test")
+set_tests_properties(InsertionSortTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;22;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(MergeSortTest "/root/repo/_libs_build/test/merge_sort_test")
+set_tests_properties(MergeSortTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;23;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(BubbleSortTest "/root/repo/_libs_build/test/bubble_sort_test")
+set_tests_properties(BubbleSortTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;24;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(HeapSortTest "/root/repo/_libs_build/test/heap_sort_test")
+set_tests_properties(HeapSortTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;25;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(QuickSortTest "/root/repo/_libs_build/test/quick_sort_test")
+set_tests_properties(QuickSortTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;26;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(PriorityQueueTest "/root/repo/_libs_build/test/priority_queue_test")
+set_tests_properties(PriorityQueueTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;28;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(IndexedPriorityQueueTest "/root/repo/_libs_build/test/indexed_priority_queue_test")
+set_tests_properties(IndexedPriorityQueueTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;29;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(RadixHeapTest "/root/repo/_libs_build/test/radix_heap_test")
+set_tests_properties(RadixHeapTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;30;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(HeapTest "/root/repo/_libs_build/test/heap_test")
+set_tests_properties(HeapTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;31;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(UndirectedGraphTest "/root/repo/_libs_build/test/undirected_graph_test")
+set_tests_properties(UndirectedGraphTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;33;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(UndirectedGraphAvx2Test "/root/repo/_libs_build/test/undirected_graph_avx2_test")
+set_tests_properties(UndirectedGraphAvx2Test PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;35;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(DirectedGraphTest "/root/repo/_libs_build/test/directed_graph_test")
+set_tests_properties(DirectedGraphTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;37;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspAcoTest "/root/repo/_libs_build/test/tsp_aco_test")
+set_tests_properties(TspAcoTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;38;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspAnnealTest "/root/repo/_libs_build/test/tsp_anneal_test")
+set_tests_properties(TspAnnealTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;39;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspAsyncTest "/root/repo/_libs_build/test/tsp_async_test")
+set_tests_properties(TspAsyncTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;40;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspBoundTest "/root/repo/_libs_build/test/tsp_bound_test")
+set_tests_properties(TspBoundTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;41;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspClusterTest "/root/repo/_libs_build/test/tsp_cluster_test")
+set_tests_properties(TspClusterTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;42;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspCacheTest "/root/repo/_libs_build/test/tsp_cache_test")
+set_tests_properties(TspCacheTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;43;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspResolveTest "/root/repo/_libs_build/test/tsp_resolve_test")
+set_tests_properties(TspResolveTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;44;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspSmallTest "/root/repo/_libs_build/test/tsp_small_test")
+set_tests_properties(TspSmallTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;45;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(TspTranspositionTableTest "/root/repo/_libs_build/test/tsp_transposition_table_test")
+set_tests_properties(TspTranspositionTableTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;46;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(ThreadPoolTest "/root/repo/_libs_build/test/thread_pool_test")
+set_tests_properties(ThreadPoolTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;47;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(LinkedListTest "/root/repo/_libs_build/test/linked_list_test")
+set_tests_properties(LinkedListTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;50;add_test;/root/repo/libs/CMakeLists.txt;0;")
+add_test(HashTableTest "/root/repo/_libs_build/test/hash_table_test")
+set_tests_properties(HashTableTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libs/CMakeLists.txt;51;add_test;/root/repo/libs/CMakeLists.txt;0;")
+subdirs("algorithms")
+subdirs("data_structures")
+subdirs("test")
+subdirs("bench")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/array_list_bench.dir/array_list_bench.cpp.o"
+  "CMakeFiles/array_list_bench.dir/array_list_bench.cpp.o.d"
+  "array_list_bench"
+  "array_list_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/array_list_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/binary_search_tree_bench.dir/binary_search_tree_bench.cpp.o"
+  "CMakeFiles/binary_search_tree_bench.dir/binary_search_tree_bench.cpp.o.d"
+  "binary_search_tree_bench"
+  "binary_search_tree_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/binary_search_tree_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hash_table_bench.dir/hash_table_bench.cpp.o"
+  "CMakeFiles/hash_table_bench.dir/hash_table_bench.cpp.o.d"
+  "hash_table_bench"
+  "hash_table_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hash_table_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/linked_list_bench.dir/linked_list_bench.cpp.o"
+  "CMakeFiles/linked_list_bench.dir/linked_list_bench.cpp.o.d"
+  "linked_list_bench"
+  "linked_list_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/linked_list_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
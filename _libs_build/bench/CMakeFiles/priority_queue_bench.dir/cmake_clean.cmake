@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/priority_queue_bench.dir/priority_queue_bench.cpp.o"
+  "CMakeFiles/priority_queue_bench.dir/priority_queue_bench.cpp.o.d"
+  "priority_queue_bench"
+  "priority_queue_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/priority_queue_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/array_list_test.dir/array_list_test.cpp.o"
+  "CMakeFiles/array_list_test.dir/array_list_test.cpp.o.d"
+  "array_list_test"
+  "array_list_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/array_list_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
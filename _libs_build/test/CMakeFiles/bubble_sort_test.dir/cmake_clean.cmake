@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bubble_sort_test.dir/bubble_sort_test.cpp.o"
+  "CMakeFiles/bubble_sort_test.dir/bubble_sort_test.cpp.o.d"
+  "bubble_sort_test"
+  "bubble_sort_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bubble_sort_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/heap_sort_test.dir/heap_sort_test.cpp.o"
+  "CMakeFiles/heap_sort_test.dir/heap_sort_test.cpp.o.d"
+  "heap_sort_test"
+  "heap_sort_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/heap_sort_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
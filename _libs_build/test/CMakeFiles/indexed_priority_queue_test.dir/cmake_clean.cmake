@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/indexed_priority_queue_test.dir/indexed_priority_queue_test.cpp.o"
+  "CMakeFiles/indexed_priority_queue_test.dir/indexed_priority_queue_test.cpp.o.d"
+  "indexed_priority_queue_test"
+  "indexed_priority_queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/indexed_priority_queue_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/insertion_sort_test.dir/insertion_sort_test.cpp.o"
+  "CMakeFiles/insertion_sort_test.dir/insertion_sort_test.cpp.o.d"
+  "insertion_sort_test"
+  "insertion_sort_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/insertion_sort_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
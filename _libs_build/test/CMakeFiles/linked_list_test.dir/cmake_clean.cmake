@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/linked_list_test.dir/linked_list_test.cpp.o"
+  "CMakeFiles/linked_list_test.dir/linked_list_test.cpp.o.d"
+  "linked_list_test"
+  "linked_list_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/linked_list_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/merge_sort_test.dir/merge_sort_test.cpp.o"
+  "CMakeFiles/merge_sort_test.dir/merge_sort_test.cpp.o.d"
+  "merge_sort_test"
+  "merge_sort_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/merge_sort_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/priority_queue_test.dir/priority_queue_test.cpp.o"
+  "CMakeFiles/priority_queue_test.dir/priority_queue_test.cpp.o.d"
+  "priority_queue_test"
+  "priority_queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/priority_queue_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
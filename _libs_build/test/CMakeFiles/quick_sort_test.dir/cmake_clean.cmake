@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/quick_sort_test.dir/quick_sort_test.cpp.o"
+  "CMakeFiles/quick_sort_test.dir/quick_sort_test.cpp.o.d"
+  "quick_sort_test"
+  "quick_sort_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quick_sort_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
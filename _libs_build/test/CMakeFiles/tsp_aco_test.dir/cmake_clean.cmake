@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_aco_test.dir/tsp_aco_test.cpp.o"
+  "CMakeFiles/tsp_aco_test.dir/tsp_aco_test.cpp.o.d"
+  "tsp_aco_test"
+  "tsp_aco_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_aco_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
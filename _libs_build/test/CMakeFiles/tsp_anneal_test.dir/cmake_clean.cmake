@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_anneal_test.dir/tsp_anneal_test.cpp.o"
+  "CMakeFiles/tsp_anneal_test.dir/tsp_anneal_test.cpp.o.d"
+  "tsp_anneal_test"
+  "tsp_anneal_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_anneal_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_async_test.dir/tsp_async_test.cpp.o"
+  "CMakeFiles/tsp_async_test.dir/tsp_async_test.cpp.o.d"
+  "tsp_async_test"
+  "tsp_async_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_async_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_bound_test.dir/tsp_bound_test.cpp.o"
+  "CMakeFiles/tsp_bound_test.dir/tsp_bound_test.cpp.o.d"
+  "tsp_bound_test"
+  "tsp_bound_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_bound_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
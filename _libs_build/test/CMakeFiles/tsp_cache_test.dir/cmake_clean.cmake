@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_cache_test.dir/tsp_cache_test.cpp.o"
+  "CMakeFiles/tsp_cache_test.dir/tsp_cache_test.cpp.o.d"
+  "tsp_cache_test"
+  "tsp_cache_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_cache_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
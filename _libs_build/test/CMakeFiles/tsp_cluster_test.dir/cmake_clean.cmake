@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_cluster_test.dir/tsp_cluster_test.cpp.o"
+  "CMakeFiles/tsp_cluster_test.dir/tsp_cluster_test.cpp.o.d"
+  "tsp_cluster_test"
+  "tsp_cluster_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_cluster_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_resolve_test.dir/tsp_resolve_test.cpp.o"
+  "CMakeFiles/tsp_resolve_test.dir/tsp_resolve_test.cpp.o.d"
+  "tsp_resolve_test"
+  "tsp_resolve_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_resolve_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_small_test.dir/tsp_small_test.cpp.o"
+  "CMakeFiles/tsp_small_test.dir/tsp_small_test.cpp.o.d"
+  "tsp_small_test"
+  "tsp_small_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_small_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tsp_transposition_table_test.dir/tsp_transposition_table_test.cpp.o"
+  "CMakeFiles/tsp_transposition_table_test.dir/tsp_transposition_table_test.cpp.o.d"
+  "tsp_transposition_table_test"
+  "tsp_transposition_table_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tsp_transposition_table_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/undirected_graph_test.dir/undirected_graph_test.cpp.o"
+  "CMakeFiles/undirected_graph_test.dir/undirected_graph_test.cpp.o.d"
+  "undirected_graph_test"
+  "undirected_graph_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/undirected_graph_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,46 @@
+#pragma once
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+#include "array_list.hpp"
+
+/* Batch mode: main batch --algo bnb --jobs 8 data/ 'more/graph??.tsp', see print_usage for the options */
+
+namespace batch {
+    /* Options parsed from the command line */
+    struct options {
+        std::string algorithm = "bnb";
+        /* 0 means one worker per hardware thread */
+        int jobs = 0;
+        /* 0 means no limit */
+        int time_limit_ms = 0;
+        int node_limit = 0;
+        std::string format = "csv";
+        std::string output;
+        /* files, directories or patterns with * and ? in the file name */
+        ds::array_list<std::string> inputs;
+    };
+
+    /*********************************************************************
+     * @brief: parse the arguments following "batch"
+     * @return: false (after printing the reason to std::cerr) on error
+     *********************************************************************/
+    bool parse_options(int, char **, options &);
+
+    void print_usage(std::ostream &);
+
+    /*********************************************************************
+     * @brief: expand the inputs into a list of instance files, largest
+     *         file first so long solves start early
+     *********************************************************************/
+    ds::array_list<std::string> collect_files(const ds::array_list<std::string> &);
+
+    /* Entry point of the batch command, returns the process exit code */
+    int run(int, char **);
+}
+
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+#include "array_list.hpp"
+
+/* Non-interactive benchmark mode: main bench --algo bnb,bf --sizes 8..14 --reps 20 --seed 1 */
+
+namespace bench {
+    /* Options parsed from the command line */
+    struct options {
+        ds::array_list<std::string> algorithms;
+        ds::array_list<int> sizes;
+        ds::array_list<std::string> files;
+        int reps = 10;
+        int warmup = 1;
+        unsigned int seed = 1;
+        int cost_low_bound = 1;
+        int cost_high_bound = 100;
+        /* 0 means no limit */
+        int time_limit_ms = 0;
+        int node_limit = 0;
+        std::string format = "csv";
+        std::string output;
+    };
+
+    /* One row of the report: timing statistics of one solver on one instance */
+    struct result {
+        std::string algorithm;
+        std::string instance;
+        std::size_t vertices;
+        int reps;
+        double min_us;
+        double median_us;
+        double p95_us;
+        std::size_t nodes;
+        int cost;
+        /* optimality gap of the last repetition, 0 unless a limit was hit */
+        double gap;
+    };
+
+    /*********************************************************************
+     * @brief: parse the arguments following "bench"
+     * @params: argc, argv - the remaining arguments, opts - filled in
+     * @return: false (after printing the reason to std::cerr) on error
+     *********************************************************************/
+    bool parse_options(int, char **, options &);
+
+    void print_usage(std::ostream &);
+
+    /* Write the report as csv or as a json array */
+    void write_csv(std::ostream &, const ds::array_list<result> &);
+    void write_json(std::ostream &, const ds::array_list<result> &);
+
+    /* Entry point of the bench command, returns the process exit code */
+    int run(int, char **);
+}
+
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string>
+#include <utility>
+
+#include "array_list.hpp"
+
+/* Minimal JSON reader for the request lines of the serve command */
+
+namespace json {
+    struct value {
+        enum kind_type { null_kind, bool_kind, number_kind, string_kind, array_kind, object_kind };
+
+        kind_type kind = null_kind;
+        bool boolean = false;
+        double number = 0;
+        std::string string;
+        ds::array_list<value> array;
+        ds::array_list<std::pair<std::string, value>> object;
+
+        bool is_number() const { return kind == number_kind; }
+        bool is_string() const { return kind == string_kind; }
+        bool is_array() const { return kind == array_kind; }
+        bool is_object() const { return kind == object_kind; }
+
+        /* Member of an object, nullptr if absent or not an object */
+        const value* find(const std::string &) const;
+    };
+
+    /*****************************************************************
+     * @brief: parse one JSON document
+     * @params: text - the document, error - set when parsing fails
+     * @return: false if text is not valid JSON
+     *****************************************************************/
+    bool parse(const std::string &, value &, std::string &);
+
+    /* Quote and escape a string for output */
+    std::string quote(const std::string &);
+}
+
+#endif
@@ -168,24 +168,28 @@ void menu::solve_tsp() {
 
     
     if (algorithm_choice == 1) {
-        auto time = util::bench_time<std::chrono::milliseconds>([&copy]() {
-            auto [min_cost, tour] = copy.tsp_brute_force(0);
+        ds::tsp_stats stats;
+        auto time = util::bench_time<std::chrono::milliseconds>([&copy, &stats]() {
+            auto [min_cost, tour] = copy.tsp_brute_force(0, stats);
 
             std::cout << "Min cost: " << min_cost << std::endl;
             std::cout << "Min tour: ";
             util::print_array(tour); std::cout << std::endl;
         });
         std::cout << "Time: " << time.count() << " ms" << std::endl;
+        std::cout << stats;
 
     } else if (algorithm_choice == 2) {
-        auto time = util::bench_time<std::chrono::milliseconds>([&copy]() {
-            auto [min_cost, tour] = copy.tsp_bnb_v2(0);
+        ds::tsp_stats stats;
+        auto time = util::bench_time<std::chrono::milliseconds>([&copy, &stats]() {
+            auto [min_cost, tour] = copy.tsp_bnb_v2(0, stats);
 
             std::cout << "Min cost: " << min_cost << std::endl;
             std::cout << "Min tour: ";
             util::print_array(tour); std::cout << std::endl;
         });
         std::cout << "Time: " << time.count() << " ms" << std::endl;
+        std::cout << stats;
     }
     
     
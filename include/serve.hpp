@@ -0,0 +1,52 @@
+#pragma once
+#ifndef SERVE_HPP
+#define SERVE_HPP
+
+#include <string>
+#include <cstddef>
+
+namespace ds {
+    class tsp_cache;
+}
+
+/**********************************************************************
+ * Long running solver:
+ *      main serve [--socket PATH] [--jobs N] [--cache N] [--cache-file PATH]
+ *
+ * Reads one JSON request per line from stdin, or from every client of
+ * a Unix domain socket, and answers with one JSON line per request.
+ * Requests are solved concurrently on a warm thread pool, so answers
+ * can come back out of order and carry the id of their request. Each
+ * solve runs on one worker of that pool, the parallel heuristics
+ * start no threads per request.
+ * Optimal results are cached, a repeated instance is answered from
+ * the cache with "cached": true.
+ *
+ * Request:  {"id": 1, "algo": "bnb", "start": 0, "matrix": [[0, 3], [3, 0]],
+ *            "time_limit_ms": 200, "node_limit": 100000}
+ *           "file": "path" may be given instead of "matrix"
+ * Response: {"id": 1, "status": "optimal", "cost": 6, "lower_bound": 6,
+ *            "gap": 0, "tour": [0, 1, 0], "time_us": 3.1, "stats": {...}}
+ *           or {"id": 1, "error": "..."}
+ **********************************************************************/
+
+namespace serve {
+    struct options {
+        /* empty means stdin / stdout */
+        std::string socket_path;
+        /* 0 means one worker per hardware thread */
+        int jobs = 0;
+        /* results kept in memory, 0 disables the cache */
+        std::size_t cache_size = 1024;
+        /* file receiving evicted results, none if empty */
+        std::string cache_file;
+    };
+
+    /* Answer one request line, safe to call from several threads, cache may be null */
+    std::string handle_request(const std::string &, ds::tsp_cache *);
+
+    /* Entry point of the serve command, returns the process exit code */
+    int run(int, char **);
+}
+
+#endif
@@ -6,18 +6,29 @@
 #include <chrono>
 #include <iostream>
 #include <limits>
+#include <random>
 #include "array_list.hpp"
 
 #define clear_input() std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n') 
 
 namespace util {
     ds::array_list<ds::array_list<int>> read_matrix_from_file(const std::string &);
+
+    /* Read a TSPLIB file: EXPLICIT weights or EUC_2D, CEIL_2D, ATT coordinates
+       Returns an empty matrix if the file can not be read or parsed */
+    ds::array_list<ds::array_list<int>> read_tsplib_file(const std::string &);
+
+    /* Read a TSPLIB file if it has a TSPLIB header, a plain matrix otherwise */
+    ds::array_list<ds::array_list<int>> read_instance_file(const std::string &);
     void print_matrix(ds::array_list<ds::array_list<int>> &);
     void print_array(ds::array_list<int> &);
 
     ds::array_list<ds::array_list<int>> generate_symmetric_cost_matrix(int, int, int);
     ds::array_list<ds::array_list<int>> generate_cost_matrix(int, int, int);
 
+    /* Same as above but draws from the given engine, so a fixed seed gives a fixed matrix */
+    ds::array_list<ds::array_list<int>> generate_symmetric_cost_matrix(int, int, int, std::mt19937 &);
+
     int generate_random_num(const int &, const int &);
 
     template<typename Duration = std::chrono::nanoseconds, typename F, typename ... Args>
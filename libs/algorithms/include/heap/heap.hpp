@@ -65,6 +65,11 @@ namespace algo {
         template <typename T, typename Compare = std::less<T>>
         void push_heap(T *first, T *last, Compare compare = Compare()) {
             auto current = last - first - 1;
+
+            if (current <= 0) {
+                return;
+            }
+
             auto parent_index = parent(current);
 
             /* While the parent[i] < i  */
@@ -79,10 +84,50 @@ namespace algo {
             }
          }
 
+        /* Move the element at index towards the root while its parent compares less,
+           moved(element, index) is called for every element that lands on a new index */
+        template <typename T, typename Compare, typename Moved>
+        void sift_up(T *first, std::size_t index, Compare compare, Moved moved) {
+            T value = *(first + index);
+
+            while (index > 0 && compare(*(first + parent(index)), value)) {
+                *(first + index) = *(first + parent(index));
+                moved(*(first + index), index);
+                index = parent(index);
+            }
+
+            *(first + index) = value;
+            moved(*(first + index), index);
+        }
+
+        /* Move the element at index towards the leaves while a child compares greater,
+           moved(element, index) is called for every element that lands on a new index */
+        template <typename T, typename Compare, typename Moved>
+        void sift_down(T *first, T *last, std::size_t index, Compare compare, Moved moved) {
+            std::size_t size = last - first;
+            T value = *(first + index);
+
+            while (left(index) < size) {
+                std::size_t child = left(index);
+                if (right(index) < size && compare(*(first + child), *(first + right(index)))) {
+                    child = right(index);
+                }
+                if (!compare(value, *(first + child))) {
+                    break;
+                }
+                *(first + index) = *(first + child);
+                moved(*(first + index), index);
+                index = child;
+            }
+
+            *(first + index) = value;
+            moved(*(first + index), index);
+        }
+
         template <typename T, typename Compare = std::less<T>> 
         void pop_heap(T *first, T *last, Compare compare = Compare()) {
             std::swap(*first, *(last - 1));
-            heapify(first, last - 2, 0, compare);
+            heapify(first, last - 1, 0, compare);
         }
 
     }
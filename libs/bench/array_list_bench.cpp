@@ -0,0 +1,134 @@
+#include "microbench.hpp"
+#include "array_list.hpp"
+
+#include <vector>
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    const auto random = microbench::distribution::random;
+
+    for (const auto &n : microbench::sizes(cfg)) {
+        auto input = microbench::generate(random, n);
+
+        microbench::run(cfg, {"array_list", "push_back", "ds::array_list", "random", n},
+            []() { return ds::array_list<int>(); },
+            [&input](ds::array_list<int> &a) {
+                for (const auto &v : input) {
+                    a.push_back(v);
+                }
+                microbench::do_not_optimize(a.back());
+            },
+            [&input](ds::array_list<int> &a) { return a.size() == input.size(); });
+
+        microbench::run(cfg, {"array_list", "push_back", "std::vector", "random", n},
+            []() { return std::vector<int>(); },
+            [&input](std::vector<int> &a) {
+                for (const auto &v : input) {
+                    a.push_back(v);
+                }
+                microbench::do_not_optimize(a.back());
+            },
+            [&input](std::vector<int> &a) { return a.size() == input.size(); });
+
+        microbench::run(cfg, {"array_list", "iterate_sum", "ds::array_list", "random", n},
+            [&input]() {
+                ds::array_list<int> a(input.size(), 0);
+                std::copy(input.begin(), input.end(), a.begin());
+                return a;
+            },
+            [](ds::array_list<int> &a) {
+                long long sum = 0;
+                for (const auto &v : a) {
+                    sum += v;
+                }
+                microbench::do_not_optimize(sum);
+            });
+
+        microbench::run(cfg, {"array_list", "iterate_sum", "std::vector", "random", n},
+            [&input]() { return input; },
+            [](std::vector<int> &a) {
+                long long sum = 0;
+                for (const auto &v : a) {
+                    sum += v;
+                }
+                microbench::do_not_optimize(sum);
+            });
+    }
+
+    /* insert and erase at the front shift every element, so they stay on the smaller sizes */
+    for (const auto &n : microbench::sizes(cfg, 10000)) {
+        auto input = microbench::generate(random, n);
+
+        microbench::run(cfg, {"array_list", "insert_front", "ds::array_list", "random", n},
+            []() { return ds::array_list<int>(); },
+            [&input](ds::array_list<int> &a) {
+                for (const auto &v : input) {
+                    a.insert(a.begin(), v);
+                }
+                microbench::do_not_optimize(a.front());
+            },
+            [&input](ds::array_list<int> &a) { return a.size() == input.size() && a.front() == input.back(); });
+
+        microbench::run(cfg, {"array_list", "insert_front", "std::vector", "random", n},
+            []() { return std::vector<int>(); },
+            [&input](std::vector<int> &a) {
+                for (const auto &v : input) {
+                    a.insert(a.begin(), v);
+                }
+                microbench::do_not_optimize(a.front());
+            },
+            [&input](std::vector<int> &a) { return a.size() == input.size() && a.front() == input.back(); });
+
+        microbench::run(cfg, {"array_list", "insert_middle", "ds::array_list", "random", n},
+            []() { return ds::array_list<int>(); },
+            [&input](ds::array_list<int> &a) {
+                for (const auto &v : input) {
+                    a.insert(a.begin() + a.size() / 2, v);
+                }
+                microbench::do_not_optimize(a.front());
+            },
+            [&input](ds::array_list<int> &a) { return a.size() == input.size(); });
+
+        microbench::run(cfg, {"array_list", "insert_middle", "std::vector", "random", n},
+            []() { return std::vector<int>(); },
+            [&input](std::vector<int> &a) {
+                for (const auto &v : input) {
+                    a.insert(a.begin() + a.size() / 2, v);
+                }
+                microbench::do_not_optimize(a.front());
+            },
+            [&input](std::vector<int> &a) { return a.size() == input.size(); });
+
+        microbench::run(cfg, {"array_list", "erase_front", "ds::array_list", "random", n},
+            [&input]() {
+                ds::array_list<int> a(input.size(), 0);
+                std::copy(input.begin(), input.end(), a.begin());
+                return a;
+            },
+            [](ds::array_list<int> &a) {
+                while (!a.empty()) {
+                    a.erase(a.begin());
+                }
+                microbench::clobber();
+            },
+            [](ds::array_list<int> &a) { return a.empty(); });
+
+        microbench::run(cfg, {"array_list", "erase_front", "std::vector", "random", n},
+            [&input]() { return input; },
+            [](std::vector<int> &a) {
+                while (!a.empty()) {
+                    a.erase(a.begin());
+                }
+                microbench::clobber();
+            },
+            [](std::vector<int> &a) { return a.empty(); });
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "microbench.hpp"
+#include "binary_search_tree.hpp"
+
+#include <map>
+#include <vector>
+
+namespace {
+    template <typename Map>
+    Map build(const std::vector<int> &input) {
+        Map m;
+        for (const auto &k : input) {
+            m.insert(std::make_pair(k, k));
+        }
+        return m;
+    }
+
+    /* n distinct keys, shuffled or in increasing order */
+    std::vector<int> keys(microbench::distribution d, std::size_t n) {
+        std::vector<int> ret(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ret[i] = static_cast<int>(i);
+        }
+        if (d == microbench::distribution::random) {
+            std::shuffle(ret.begin(), ret.end(), std::mt19937(42));
+        }
+        return ret;
+    }
+
+    template <typename Map>
+    void run_suite(const microbench::config &cfg, const char *impl, microbench::distribution d, std::size_t n) {
+        auto input = keys(d, n);
+        auto dist = microbench::distribution_name(d);
+
+        microbench::run(cfg, {"binary_search_tree", "insert", impl, dist, n},
+            []() { return Map(); },
+            [&input](Map &m) {
+                for (const auto &k : input) {
+                    m.insert(std::make_pair(k, k));
+                }
+                microbench::clobber();
+            },
+            [&input](Map &m) { return m.size() == input.size(); });
+
+        microbench::run(cfg, {"binary_search_tree", "find", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [&input](Map &m) {
+                std::size_t found = 0;
+                for (const auto &k : input) {
+                    found += m.find(k) != m.end();
+                }
+                microbench::do_not_optimize(found);
+            });
+
+        microbench::run(cfg, {"binary_search_tree", "iterate_sum", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [](Map &m) {
+                long long sum = 0;
+                for (auto it = m.begin(); it != m.end(); ++it) {
+                    sum += (*it).second;
+                }
+                microbench::do_not_optimize(sum);
+            });
+
+        microbench::run(cfg, {"binary_search_tree", "erase", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [&input](Map &m) {
+                for (const auto &k : input) {
+                    m.erase(k);
+                }
+                microbench::clobber();
+            },
+            [](Map &m) { return m.empty(); });
+    }
+}
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    for (const auto &n : microbench::sizes(cfg)) {
+        run_suite<ds::binary_search_tree<int, int>>(cfg, "ds::binary_search_tree", microbench::distribution::random, n);
+        run_suite<std::map<int, int>>(cfg, "std::map", microbench::distribution::random, n);
+    }
+
+    /* the tree is unbalanced, sorted keys degenerate it into a list */
+    for (const auto &n : microbench::sizes(cfg, 10000)) {
+        run_suite<ds::binary_search_tree<int, int>>(cfg, "ds::binary_search_tree", microbench::distribution::sorted, n);
+        run_suite<std::map<int, int>>(cfg, "std::map", microbench::distribution::sorted, n);
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "microbench.hpp"
+#include "hash_table.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    /* Keys 0..n-1 in order, or n distinct keys in random order */
+    std::vector<int> keys(microbench::distribution d, std::size_t n) {
+        std::vector<int> ret(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            ret[i] = static_cast<int>(i);
+        }
+        if (d == microbench::distribution::random) {
+            std::shuffle(ret.begin(), ret.end(), std::mt19937(42));
+        }
+        return ret;
+    }
+
+    template <typename Map>
+    Map build(const std::vector<int> &input) {
+        Map m;
+        for (const auto &k : input) {
+            m.insert(std::make_pair(k, k));
+        }
+        return m;
+    }
+
+    template <typename Map>
+    void run_suite(const microbench::config &cfg, const char *impl, microbench::distribution d, std::size_t n) {
+        auto input = keys(d, n);
+        auto dist = microbench::distribution_name(d);
+
+        microbench::run(cfg, {"hash_table", "insert", impl, dist, n},
+            []() { return Map(); },
+            [&input](Map &m) {
+                for (const auto &k : input) {
+                    m.insert(std::make_pair(k, k));
+                }
+                microbench::clobber();
+            },
+            [&input](Map &m) { return m.size() == input.size(); });
+
+        microbench::run(cfg, {"hash_table", "find_hit", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [&input](Map &m) {
+                std::size_t found = 0;
+                for (const auto &k : input) {
+                    found += m.find(k) != m.end();
+                }
+                microbench::do_not_optimize(found);
+            });
+
+        microbench::run(cfg, {"hash_table", "find_miss", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [&input, n](Map &m) {
+                std::size_t found = 0;
+                for (const auto &k : input) {
+                    found += m.find(k + static_cast<int>(n)) != m.end();
+                }
+                microbench::do_not_optimize(found);
+            });
+
+        microbench::run(cfg, {"hash_table", "erase", impl, dist, n},
+            [&input]() { return build<Map>(input); },
+            [&input](Map &m) {
+                for (const auto &k : input) {
+                    m.erase(k);
+                }
+                microbench::clobber();
+            },
+            [](Map &m) { return m.empty(); });
+    }
+}
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    for (const auto &d : {microbench::distribution::sorted, microbench::distribution::random}) {
+        for (const auto &n : microbench::sizes(cfg)) {
+            run_suite<ds::hash_table<int, int>>(cfg, "ds::hash_table", d, n);
+            run_suite<std::unordered_map<int, int>>(cfg, "std::unordered_map", d, n);
+        }
+    }
+
+    return 0;
+}
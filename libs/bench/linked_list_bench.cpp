@@ -0,0 +1,110 @@
+#include "microbench.hpp"
+#include "linked_list.hpp"
+
+#include <list>
+#include <vector>
+
+namespace {
+    template <typename List>
+    List build(const std::vector<int> &input) {
+        List l;
+        for (const auto &v : input) {
+            l.push_back(v);
+        }
+        return l;
+    }
+
+    template <typename List>
+    void run_suite(const microbench::config &cfg, const char *impl, std::size_t n) {
+        auto input = microbench::generate(microbench::distribution::random, n);
+
+        microbench::run(cfg, {"linked_list", "push_back", impl, "random", n},
+            []() { return List(); },
+            [&input](List &l) {
+                for (const auto &v : input) {
+                    l.push_back(v);
+                }
+                microbench::do_not_optimize(l.back());
+            },
+            [&input](List &l) { return l.size() == input.size() && l.back() == input.back(); });
+
+        microbench::run(cfg, {"linked_list", "push_front", impl, "random", n},
+            []() { return List(); },
+            [&input](List &l) {
+                for (const auto &v : input) {
+                    l.push_front(v);
+                }
+                microbench::do_not_optimize(l.front());
+            },
+            [&input](List &l) { return l.size() == input.size() && l.front() == input.back(); });
+
+        microbench::run(cfg, {"linked_list", "iterate_sum", impl, "random", n},
+            [&input]() { return build<List>(input); },
+            [](List &l) {
+                long long sum = 0;
+                for (auto it = l.begin(); it != l.end(); ++it) {
+                    sum += *it;
+                }
+                microbench::do_not_optimize(sum);
+            });
+
+        microbench::run(cfg, {"linked_list", "pop_front", impl, "random", n},
+            [&input]() { return build<List>(input); },
+            [](List &l) {
+                while (!l.empty()) {
+                    l.pop_front();
+                }
+                microbench::clobber();
+            },
+            [](List &l) { return l.empty(); });
+
+        microbench::run(cfg, {"linked_list", "erase_front", impl, "random", n},
+            [&input]() { return build<List>(input); },
+            [](List &l) {
+                while (!l.empty()) {
+                    l.erase(l.begin());
+                }
+                microbench::clobber();
+            },
+            [](List &l) { return l.empty(); });
+    }
+
+    /* linear search, kept to the smaller sizes */
+    template <typename List, typename Find>
+    void run_find(const microbench::config &cfg, const char *impl, std::size_t n, Find find) {
+        auto input = microbench::generate(microbench::distribution::random, n);
+
+        microbench::run(cfg, {"linked_list", "find_100", impl, "random", n},
+            [&input]() { return build<List>(input); },
+            [&input, &find](List &l) {
+                std::size_t found = 0;
+                for (std::size_t i = 0; i < 100; ++i) {
+                    found += find(l, input[i * input.size() / 100]);
+                }
+                microbench::do_not_optimize(found);
+            });
+    }
+}
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    for (const auto &n : microbench::sizes(cfg)) {
+        run_suite<ds::linked_list<int>>(cfg, "ds::linked_list", n);
+        run_suite<std::list<int>>(cfg, "std::list", n);
+
+        run_find<ds::linked_list<int>>(cfg, "ds::linked_list", n, [](ds::linked_list<int> &l, int v) {
+            return l.find(v) != l.end();
+        });
+        run_find<std::list<int>>(cfg, "std::list", n, [](std::list<int> &l, int v) {
+            return std::find(l.begin(), l.end(), v) != l.end();
+        });
+    }
+
+    return 0;
+}
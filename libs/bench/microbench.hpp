@@ -0,0 +1,221 @@
+/*************************************************************
+ * Minimal microbenchmark harness for the libs containers and
+ * algorithms: warmup, repetition, optimization barriers and
+ * csv / json-lines output
+ *************************************************************/
+#pragma once
+#ifndef MICROBENCH_HPP
+#define MICROBENCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <atomic>
+
+namespace microbench {
+
+    /*************************************************************
+     * @brief: Make the compiler assume value is read, so the
+     *         computation producing it can not be optimized away
+     *************************************************************/
+    template <typename T>
+    inline void do_not_optimize(T const &value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void *sink;
+        sink = &value;
+#endif
+    }
+
+    /*************************************************************
+     * @brief: Make the compiler assume all memory was written, so
+     *         stores before this point can not be elided
+     *************************************************************/
+    inline void clobber() {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : : "memory");
+#else
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+    }
+
+    /* Options shared by every benchmark executable */
+    struct config {
+        int warmup = 2;
+        int reps = 10;
+        std::size_t max_size = 100000;
+        bool json = false;
+    };
+
+    /*************************************************************
+     * @brief: Parse --warmup N --reps N --max-size N --format FMT
+     * @return: false on an unknown option or a missing value
+     *************************************************************/
+    inline bool parse_config(int argc, char **argv, config &cfg) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+
+            if (arg == "--warmup") {
+                cfg.warmup = std::stoi(value);
+            } else if (arg == "--reps") {
+                cfg.reps = std::max(1, std::stoi(value));
+            } else if (arg == "--max-size") {
+                cfg.max_size = std::stoul(value);
+            } else if (arg == "--format") {
+                cfg.json = value == "json";
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--warmup N] [--reps N] [--max-size N] [--format csv|json]" << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Identifies one benchmark case, one output row per case */
+    struct benchmark_case {
+        std::string suite;
+        std::string operation;
+        std::string implementation;
+        std::string distribution;
+        std::size_t size;
+    };
+
+    /* Header of the csv output, json output is one object per line */
+    inline void print_header(const config &cfg) {
+        if (!cfg.json) {
+            std::cout << "suite,operation,impl,distribution,n,reps,min_ns,median_ns,mean_ns,ns_per_elem,valid" << std::endl;
+        }
+    }
+
+    inline void print_row(const config &cfg, const benchmark_case &bc, std::vector<double> &times, bool valid) {
+        std::sort(times.begin(), times.end());
+
+        double mean = 0;
+        for (const auto &t : times) {
+            mean += t;
+        }
+        mean /= times.size();
+
+        double median = times.size() % 2 == 1 ? times[times.size() / 2]
+            : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+        double per_elem = bc.size == 0 ? median : median / bc.size;
+
+        if (cfg.json) {
+            std::cout << "{\"suite\": \"" << bc.suite << "\", \"operation\": \"" << bc.operation
+                      << "\", \"impl\": \"" << bc.implementation << "\", \"distribution\": \"" << bc.distribution
+                      << "\", \"n\": " << bc.size << ", \"reps\": " << times.size()
+                      << ", \"min_ns\": " << times.front() << ", \"median_ns\": " << median
+                      << ", \"mean_ns\": " << mean << ", \"ns_per_elem\": " << per_elem
+                      << ", \"valid\": " << (valid ? "true" : "false") << "}" << std::endl;
+        } else {
+            std::cout << bc.suite << "," << bc.operation << "," << bc.implementation << "," << bc.distribution << ","
+                      << bc.size << "," << times.size() << "," << times.front() << "," << median << ","
+                      << mean << "," << per_elem << "," << (valid ? 1 : 0) << std::endl;
+        }
+    }
+
+    /* Default check for benchmarks whose result can not be wrong */
+    struct always_valid {
+        template <typename State>
+        bool operator()(State &) const {
+            return true;
+        }
+    };
+
+    /*************************************************************
+     * @brief: Run one benchmark case and print its row
+     * @params:
+     *      setup - builds a fresh input state, not timed
+     *      body  - the timed operation on the state
+     *      check - validates the state after the last repetition
+     *************************************************************/
+    template <typename Setup, typename Body, typename Check = always_valid>
+    void run(const config &cfg, const benchmark_case &bc, Setup setup, Body body, Check check = Check()) {
+        for (int i = 0; i < cfg.warmup; ++i) {
+            auto state = setup();
+            body(state);
+            clobber();
+        }
+
+        std::vector<double> times;
+        bool valid = true;
+        for (int i = 0; i < cfg.reps; ++i) {
+            auto state = setup();
+            clobber();
+            const auto beg = std::chrono::steady_clock::now();
+            body(state);
+            clobber();
+            const auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::nano>(end - beg).count());
+
+            if (i + 1 == cfg.reps) {
+                valid = check(state);
+            }
+        }
+
+        print_row(cfg, bc, times, valid);
+    }
+
+    /* Input distributions used across the suites */
+    enum class distribution { random, sorted, reversed, few_unique };
+
+    inline const char* distribution_name(distribution d) {
+        switch (d) {
+            case distribution::random: return "random";
+            case distribution::sorted: return "sorted";
+            case distribution::reversed: return "reversed";
+            case distribution::few_unique: return "few_unique";
+        }
+        return "";
+    }
+
+    /* Generate n ints of the given distribution, always the same for the same arguments */
+    inline std::vector<int> generate(distribution d, std::size_t n, std::uint32_t seed = 42) {
+        std::mt19937 rng(seed);
+        std::vector<int> ret(n);
+
+        if (d == distribution::few_unique) {
+            std::uniform_int_distribution<int> dist(0, 15);
+            for (auto &v : ret) {
+                v = dist(rng);
+            }
+            return ret;
+        }
+
+        std::uniform_int_distribution<int> dist(0, static_cast<int>(n) * 8);
+        for (auto &v : ret) {
+            v = dist(rng);
+        }
+
+        if (d == distribution::sorted) {
+            std::sort(ret.begin(), ret.end());
+        } else if (d == distribution::reversed) {
+            std::sort(ret.begin(), ret.end(), std::greater<int>());
+        }
+
+        return ret;
+    }
+
+    /* Sizes to benchmark, each case gets every size up to min(limit, cfg.max_size) */
+    inline std::vector<std::size_t> sizes(const config &cfg, std::size_t limit = 100000) {
+        std::vector<std::size_t> ret;
+        for (std::size_t n = 100; n <= std::min(limit, cfg.max_size); n *= 10) {
+            ret.push_back(n);
+        }
+        return ret;
+    }
+}
+
+#endif
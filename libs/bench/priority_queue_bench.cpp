@@ -0,0 +1,72 @@
+#include "microbench.hpp"
+#include "priority_queue.hpp"
+
+#include <queue>
+#include <vector>
+
+namespace {
+    template <typename Queue>
+    Queue build(const std::vector<int> &input) {
+        Queue q;
+        for (const auto &v : input) {
+            q.push(v);
+        }
+        return q;
+    }
+
+    /* Pops everything and records whether the values came out in non-increasing order */
+    template <typename Queue>
+    struct drained {
+        Queue queue;
+        bool ordered = true;
+    };
+
+    template <typename Queue>
+    void run_suite(const microbench::config &cfg, const char *impl, microbench::distribution d, std::size_t n) {
+        auto input = microbench::generate(d, n);
+        auto dist = microbench::distribution_name(d);
+
+        microbench::run(cfg, {"priority_queue", "push", impl, dist, n},
+            []() { return Queue(); },
+            [&input](Queue &q) {
+                for (const auto &v : input) {
+                    q.push(v);
+                }
+                microbench::do_not_optimize(q.top());
+            },
+            [&input](Queue &q) { return q.size() == input.size(); });
+
+        microbench::run(cfg, {"priority_queue", "pop", impl, dist, n},
+            [&input]() { return drained<Queue>{build<Queue>(input)}; },
+            [](drained<Queue> &s) {
+                int last = s.queue.top();
+                while (!s.queue.empty()) {
+                    int top = s.queue.top();
+                    s.ordered = s.ordered && top <= last;
+                    last = top;
+                    s.queue.pop();
+                }
+                microbench::do_not_optimize(last);
+            },
+            [](drained<Queue> &s) { return s.ordered; });
+    }
+}
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    for (const auto &d : {microbench::distribution::random, microbench::distribution::sorted,
+                          microbench::distribution::reversed}) {
+        for (const auto &n : microbench::sizes(cfg)) {
+            run_suite<ds::priority_queue<int>>(cfg, "ds::priority_queue", d, n);
+            run_suite<std::priority_queue<int>>(cfg, "std::priority_queue", d, n);
+        }
+    }
+
+    return 0;
+}
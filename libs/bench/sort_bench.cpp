@@ -0,0 +1,80 @@
+#include "microbench.hpp"
+#include "sort.hpp"
+#include "array_list.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace {
+    typedef void (*sort_function)(int *, int *);
+
+    struct sort_routine {
+        const char *name;
+        sort_function sort;
+        /* largest input size the routine is run on */
+        std::size_t limit;
+        /* whether it degrades to O(n^2) on presorted or few unique keys */
+        bool degrades;
+    };
+
+    const sort_routine routines[] = {
+        {"std::sort", [](int *f, int *l) { std::sort(f, l); }, 100000, false},
+        {"std::stable_sort", [](int *f, int *l) { std::stable_sort(f, l); }, 100000, false},
+        {"insertion_sort", [](int *f, int *l) { algo::sort::insertion_sort(f, l); }, 10000, false},
+        {"bubble_sort", [](int *f, int *l) { algo::sort::bubble_sort(f, l); }, 10000, false},
+        {"merge_sort_recursive", [](int *f, int *l) { algo::sort::merge_sort_recursive(f, l); }, 100000, false},
+        {"merge_sort_iterative", [](int *f, int *l) { algo::sort::merge_sort_iterative(f, l); }, 100000, false},
+        {"heap_sort", [](int *f, int *l) { algo::sort::heap_sort(f, l); }, 100000, false},
+        {"quick_sort_recursive", [](int *f, int *l) { algo::sort::quick_sort_recursive(f, l); }, 100000, true},
+        {"quick_sort_iterative", [](int *f, int *l) { algo::sort::quick_sort_iterative(f, l); }, 100000, true},
+    };
+
+    const microbench::distribution distributions[] = {
+        microbench::distribution::random,
+        microbench::distribution::sorted,
+        microbench::distribution::reversed,
+        microbench::distribution::few_unique,
+    };
+}
+
+int main(int argc, char **argv) {
+    microbench::config cfg;
+    if (!microbench::parse_config(argc, argv, cfg)) {
+        return 1;
+    }
+
+    microbench::print_header(cfg);
+
+    for (const auto &routine : routines) {
+        for (const auto &d : distributions) {
+            auto limit = routine.limit;
+            if (routine.degrades && d != microbench::distribution::random) {
+                limit = std::min<std::size_t>(limit, 10000);
+            }
+
+            for (const auto &n : microbench::sizes(cfg, limit)) {
+                auto input = microbench::generate(d, n);
+                microbench::benchmark_case bc{"sort", "sort", routine.name, microbench::distribution_name(d), n};
+
+                microbench::run(cfg, bc,
+                    [&input]() {
+                        ds::array_list<int> a(input.size(), 0);
+                        std::copy(input.begin(), input.end(), a.begin());
+                        return a;
+                    },
+                    [&routine](ds::array_list<int> &a) {
+                        routine.sort(a.begin(), a.end());
+                        microbench::do_not_optimize(a.front());
+                    },
+                    [&input](ds::array_list<int> &a) {
+                        auto expected = input;
+                        std::sort(expected.begin(), expected.end());
+                        return std::equal(expected.begin(), expected.end(), a.begin());
+                    });
+            }
+        }
+    }
+
+    return 0;
+}
@@ -36,12 +36,13 @@ namespace ds {
             }
         }
 
+        /* Construct from the range [a, b) */
         array_list(const_iterator a, const_iterator b) {
-            m_size = b - a + 1;
+            m_size = b - a;
             m_capacity = m_size;
             m_data = m_allocator.allocate(m_capacity);
 
-            auto start = b;
+            auto start = a;
             auto dest = begin();
             while (start != b) {
                 m_allocator.construct(dest, *start);
@@ -0,0 +1,669 @@
+#pragma once
+#ifndef DIRECTED_GRAPH_HPP
+#define DIRECTED_GRAPH_HPP
+
+#include "array_list.hpp"
+#include "sort.hpp"
+#include "tsp_stats.hpp"
+#include "tsp_budget.hpp"
+
+#include <utility>
+#include <limits>
+#include <algorithm>
+
+/* Implementation of directed graph using adjacency matrix, edge (a, b) and (b, a) may differ */
+
+namespace ds {
+    class directed_graph {
+    public:
+        /* typedef for size type*/
+        typedef std::size_t size_type;
+
+        /* typedef for weight type of edges */
+        typedef int weight_type;
+
+        /* typedef for matrix type, row a column b is the weight of a -> b */
+        typedef ds::array_list<ds::array_list<weight_type>> matrix;
+
+        /* typedef for vertex type*/
+        typedef int vertex_type;
+
+        /* typedef for the return type of tsp procedure */
+        typedef std::pair<weight_type, ds::array_list<vertex_type>> tsp_return_type;
+
+        /* definition of edge_type, from first to second */
+        typedef std::pair<vertex_type, vertex_type> edge_type;
+
+
+        directed_graph() : cost_matrix(matrix()) {}
+
+        /**********************************************************************
+         * @brief: construct graph object from a cost matrix, asymmetric
+         *         matrices such as util::generate_cost_matrix are kept as is
+         * @param: cm - matrix
+         **********************************************************************/
+        directed_graph(const matrix &cm) : cost_matrix(cm) {}
+
+        /**********************************
+         * @brief: Copy constructor
+         * @param: other - directed_graph
+         **********************************/
+        directed_graph(const directed_graph &other) : cost_matrix(other.cost_matrix) {}
+
+        void set_cost_matrix(matrix new_matrix) {
+            cost_matrix = new_matrix;
+        }
+
+        /*************************************
+         * @brief: Overload = operator to copy
+         *************************************/
+        directed_graph& operator=(const directed_graph &other) {
+            cost_matrix = other.cost_matrix;
+            return *this;
+        }
+
+        /**********************************************************
+         * @brief: Get number of vertices
+         * @return:
+         *      size-type - denotes number of vertices in the graph
+         **********************************************************/
+        size_type vertices_size() const {
+            return cost_matrix.size();
+        }
+
+        /********************************************
+         * @brief: Get number of directed edges
+         * @return:
+         *        size_type - denotes number of edges
+         ********************************************/
+        size_type edges_size() const {
+            size_type ret = 0;
+            for (size_type i = 0; i < vertices_size(); ++i) {
+                for (size_type j = 0; j < vertices_size(); ++j) {
+                    ret += i != j && cost_matrix[i][j] != UNREACHABLE_VALUE;
+                }
+            }
+            return ret;
+        }
+
+        /*************************************************
+         * @brief: Set the weight of an edge, only in the
+         *         direction from e.first to e.second
+         * @params: edge_type e, weight_type weight
+         *************************************************/
+        void set_edge_weight(edge_type e, weight_type weight) {
+            cost_matrix[e.first][e.second] = weight;
+        }
+
+        /*************************************************
+         * @brief: Remove an edge, same as setting its
+         *         weight to UNREACHABLE_VALUE
+         * @params: edge_type e
+         *************************************************/
+        void remove_edge(edge_type e) {
+            set_edge_weight(e, UNREACHABLE_VALUE);
+        }
+
+        /*************************************************
+         * @brief: Get edge weight of an edge
+         * @params: edge_type e
+         * @return:
+         *      weight-type - the weight of e.first -> e.second
+         *************************************************/
+        weight_type edge_weight(edge_type e) const {
+            return cost_matrix[e.first][e.second];
+        }
+
+        /*************************************************
+         * @brief: Check if every edge weighs the same in
+         *         both directions, only then do the
+         *         solvers of undirected_graph apply
+         *************************************************/
+        bool symmetric() const {
+            for (size_type i = 0; i < vertices_size(); ++i) {
+                for (size_type j = i + 1; j < vertices_size(); ++j) {
+                    if (cost_matrix[i][j] != cost_matrix[j][i]) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**************************************************************
+         * @brief: Calculate the cost of a path, edges are taken in
+         *         the order of the path
+         * @params:
+         *      ds::array_list<vertex_type> - denotes the path
+         * @return:
+         *      weight_type - denotes the total cost for the path
+         **************************************************************/
+        weight_type path_cost(const ds::array_list<vertex_type> &) const;
+
+        /*************************************************************
+         * @brief: Solve the assignment problem on the cost matrix:
+         *         every vertex gets one successor and one predecessor,
+         *         no vertex is its own successor and missing edges are
+         *         not used. Every tour is an assignment, so its cost
+         *         bounds the asymmetric tsp from below
+         * @return:
+         *      weight_type - the cheapest assignment, max() if there
+         *          is none
+         *************************************************************/
+        weight_type assignment_bound() const;
+
+        /*******************************************
+         * @brief: Solve the asymmetric tsp by branch
+         *         and bound. The path is extended
+         *         from the start vertex, the bound of
+         *         a node is the assignment problem with
+         *         the path edges fixed and the edge
+         *         that would close the path early
+         *         forbidden. A child re-solves the
+         *         assignment of its parent from the
+         *         few rows the new edge frees, O(n^2)
+         *         per node instead of O(n^3). Missing
+         *         edges are never used and
+         *         budget.dp_threshold does not apply
+         * @return:
+         *      tsp_return_type (unbudgeted overloads):
+         *          the cost and the tour
+         *      tsp_result (budgeted overloads):
+         *          the best tour found, a proven lower
+         *          bound and why the search stopped
+         ******************************************/
+        tsp_return_type tsp_bnb(const vertex_type &);
+        template <class Stats>
+        tsp_return_type tsp_bnb(const vertex_type &, Stats &);
+        /* budget by value so an lvalue budget never binds to Stats & */
+        tsp_result tsp_bnb(const vertex_type &, tsp_budget);
+        template <class Stats>
+        tsp_result tsp_bnb(const vertex_type &, const tsp_budget &, Stats &);
+
+    private:
+        /* Cost of an edge the assignment may not use, far above any sum of weights */
+        static constexpr long long FORBIDDEN = 1LL << 48;
+
+        /**********************************************************
+         * Assignment problem solved by shortest augmenting paths
+         * on the reduced costs cost - u[row] - v[column], which the
+         * potentials keep non negative. Rows and columns are the
+         * vertices plus one, index 0 is the virtual column the
+         * search for an augmenting path starts from
+         **********************************************************/
+        struct assignment_state {
+            size_type n;
+            ds::array_list<long long> u;
+            ds::array_list<long long> v;
+            /* row[j]: row assigned to column j, 0 if the column is free */
+            ds::array_list<int> row;
+
+            /* scratch of one augmenting path search */
+            ds::array_list<long long> slack;
+            ds::array_list<int> way;
+            ds::array_list<bool> used;
+
+            /* fixed edges, -1 where there is none */
+            ds::array_list<vertex_type> succ;
+            ds::array_list<vertex_type> pred;
+            /* the path runs from start to end, end -> start is forbidden */
+            vertex_type start;
+            vertex_type end;
+        };
+
+        /* Search state of branch and bound, extended and undone in place */
+        struct atsp_state {
+            ds::array_list<vertex_type> path;
+            ds::array_list<bool> visited;
+            /* cost of the current path */
+            weight_type cost;
+            size_type nodes;
+            ds::array_list<ds::array_list<vertex_type>> nearest;
+            assignment_state assignment;
+            /* u, v and row of every open node, n + 1 entries each per depth */
+            ds::array_list<long long> saved_u;
+            ds::array_list<long long> saved_v;
+            ds::array_list<int> saved_row;
+        };
+
+        /* Start an assignment with nothing fixed and no row assigned */
+        assignment_state make_assignment(const vertex_type &start) const;
+
+        /* Cost of edge i -> j under the fixed edges, FORBIDDEN if it can't be used */
+        long long assignment_cost(const assignment_state &, vertex_type, vertex_type) const;
+
+        /* Assign row r through the cheapest augmenting path, O(n^2) */
+        void augment(assignment_state &, int) const;
+
+        /* Total cost of a complete assignment, FORBIDDEN or more if it uses a forbidden edge */
+        long long assignment_value(const assignment_state &) const;
+
+        /*************************************************************
+         * @brief: fix the edge from -> to. The assigned pairs that
+         *         became forbidden are freed and their rows assigned
+         *         again, the potentials stay feasible because costs
+         *         only grow
+         *************************************************************/
+        void fix_edge(assignment_state &, const vertex_type &, const vertex_type &) const;
+
+        /* Vertices sorted by the weight from each vertex, missing edges left out */
+        ds::array_list<ds::array_list<vertex_type>> nearest_successors() const;
+
+        /* Take budget.initial_tour as the incumbent if it is a tour over existing edges */
+        void warm_start(const vertex_type &, const tsp_budget &, tsp_result &) const;
+
+        /*************************************************************
+         * @brief: helper for tsp_bnb, process the node at the end of
+         *         state.path and search below it depth first
+         * @params:
+         *      atsp_state - the search state, left as it was found
+         *      long long - the assignment bound of the node
+         *      tsp_budget, tsp_result, Stats - as in tsp_bnb
+         * @return:
+         *      bool - false when the budget stopped the search, the
+         *          result lower bound then covers this subtree
+         *************************************************************/
+        template <class Stats>
+        bool tsp_bnb_search(atsp_state &, long long, const tsp_budget &, tsp_result &, Stats &);
+
+        const int UNREACHABLE_VALUE = 0;
+
+        matrix cost_matrix;
+    };
+
+    inline directed_graph::weight_type directed_graph::path_cost(const ds::array_list<directed_graph::vertex_type> &path) const {
+        weight_type total_cost = 0;
+        for (size_type i = 0; i + 1 < path.size(); ++i) {
+            total_cost += cost_matrix[path[i]][path[i + 1]];
+        }
+        return total_cost;
+    }
+
+    inline directed_graph::assignment_state directed_graph::make_assignment(const directed_graph::vertex_type &start) const {
+        const size_type n = vertices_size();
+
+        assignment_state a;
+        a.n = n;
+        a.u = ds::array_list<long long>(n + 1, 0);
+        a.v = ds::array_list<long long>(n + 1, 0);
+        a.row = ds::array_list<int>(n + 1, 0);
+        a.slack = ds::array_list<long long>(n + 1, 0);
+        a.way = ds::array_list<int>(n + 1, 0);
+        a.used = ds::array_list<bool>(n + 1, false);
+        a.succ = ds::array_list<vertex_type>(n, -1);
+        a.pred = ds::array_list<vertex_type>(n, -1);
+        a.start = start;
+        a.end = start;
+        return a;
+    }
+
+    inline long long directed_graph::assignment_cost(const directed_graph::assignment_state &a,
+            directed_graph::vertex_type i, directed_graph::vertex_type j) const {
+        if (i == j || (i == a.end && j == a.start)) {
+            return FORBIDDEN;
+        }
+        if ((a.succ[i] != -1 && a.succ[i] != j) || (a.pred[j] != -1 && a.pred[j] != i)) {
+            return FORBIDDEN;
+        }
+        weight_type w = cost_matrix[i][j];
+        return w == UNREACHABLE_VALUE ? FORBIDDEN : w;
+    }
+
+    inline void directed_graph::augment(directed_graph::assignment_state &a, int r) const {
+        const long long unset = std::numeric_limits<long long>::max();
+        const int n = static_cast<int>(a.n);
+
+        for (int j = 0; j <= n; ++j) {
+            a.slack[j] = unset;
+            a.used[j] = false;
+        }
+
+        /* grow a tree of tight edges from row r until it reaches a free column */
+        a.row[0] = r;
+        int j0 = 0;
+        do {
+            a.used[j0] = true;
+            int i0 = a.row[j0];
+            long long delta = unset;
+            int j1 = 0;
+
+            for (int j = 1; j <= n; ++j) {
+                if (a.used[j]) {
+                    continue;
+                }
+                long long reduced = assignment_cost(a, i0 - 1, j - 1) - a.u[i0] - a.v[j];
+                if (reduced < a.slack[j]) {
+                    a.slack[j] = reduced;
+                    a.way[j] = j0;
+                }
+                if (a.slack[j] < delta) {
+                    delta = a.slack[j];
+                    j1 = j;
+                }
+            }
+
+            for (int j = 0; j <= n; ++j) {
+                if (a.used[j]) {
+                    a.u[a.row[j]] += delta;
+                    a.v[j] -= delta;
+                } else {
+                    a.slack[j] -= delta;
+                }
+            }
+            j0 = j1;
+        } while (a.row[j0] != 0);
+
+        /* flip the path back to the virtual column */
+        do {
+            int j1 = a.way[j0];
+            a.row[j0] = a.row[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    inline long long directed_graph::assignment_value(const directed_graph::assignment_state &a) const {
+        long long total = 0;
+        for (size_type j = 1; j <= a.n; ++j) {
+            total += assignment_cost(a, a.row[j] - 1, static_cast<vertex_type>(j) - 1);
+        }
+        return total;
+    }
+
+    inline void directed_graph::fix_edge(directed_graph::assignment_state &a, const directed_graph::vertex_type &from,
+                                         const directed_graph::vertex_type &to) const {
+        a.succ[from] = to;
+        a.pred[to] = from;
+        a.end = to;
+
+        /* at most three pairs break: row from, column to and to -> start */
+        int freed[3];
+        int count = 0;
+        for (size_type j = 1; j <= a.n; ++j) {
+            int r = a.row[j];
+            if (r != 0 && assignment_cost(a, r - 1, static_cast<vertex_type>(j) - 1) >= FORBIDDEN) {
+                a.row[j] = 0;
+                freed[count++] = r;
+            }
+        }
+        for (int k = 0; k < count; ++k) {
+            augment(a, freed[k]);
+        }
+    }
+
+    inline directed_graph::weight_type directed_graph::assignment_bound() const {
+        if (vertices_size() < 2) {
+            return 0;
+        }
+
+        assignment_state a = make_assignment(0);
+        for (size_type i = 1; i <= a.n; ++i) {
+            augment(a, static_cast<int>(i));
+        }
+
+        long long value = assignment_value(a);
+        return value >= FORBIDDEN ? std::numeric_limits<weight_type>::max() : static_cast<weight_type>(value);
+    }
+
+    inline ds::array_list<ds::array_list<directed_graph::vertex_type>> directed_graph::nearest_successors() const {
+        ds::array_list<ds::array_list<vertex_type>> ret;
+
+        for (vertex_type v = 0; v < static_cast<vertex_type>(vertices_size()); ++v) {
+            const auto &weights = cost_matrix[v];
+            ds::array_list<vertex_type> row;
+            for (vertex_type u = 0; u < static_cast<vertex_type>(vertices_size()); ++u) {
+                if (u != v && weights[u] != UNREACHABLE_VALUE) {
+                    row.push_back(u);
+                }
+            }
+
+            algo::sort::quick_sort_recursive(row.begin(), row.end(), [&weights](const vertex_type &a, const vertex_type &b) {
+                return weights[a] < weights[b] || (weights[a] == weights[b] && a < b);
+            });
+            ret.push_back(row);
+        }
+
+        return ret;
+    }
+
+    inline void directed_graph::warm_start(const directed_graph::vertex_type &init_vertex, const tsp_budget &budget, tsp_result &result) const {
+        const auto &tour = budget.initial_tour;
+        if (tour.size() != vertices_size() + 1 || tour[0] != init_vertex || tour[tour.size() - 1] != init_vertex) {
+            return;
+        }
+
+        ds::array_list<bool> seen(vertices_size(), false);
+        for (size_type i = 0; i + 1 < tour.size(); ++i) {
+            if (tour[i] < 0 || tour[i] >= static_cast<vertex_type>(vertices_size()) || seen[tour[i]]) {
+                return;
+            }
+            if (vertices_size() > 1 && cost_matrix[tour[i]][tour[i + 1]] == UNREACHABLE_VALUE) {
+                return;
+            }
+            seen[tour[i]] = true;
+        }
+
+        result.cost = path_cost(tour);
+        result.tour = tour;
+    }
+
+    inline directed_graph::tsp_return_type directed_graph::tsp_bnb(const directed_graph::vertex_type &init_vertex) {
+        tsp_no_stats stats;
+        return tsp_bnb(init_vertex, stats);
+    }
+
+    template <class Stats>
+    directed_graph::tsp_return_type directed_graph::tsp_bnb(const directed_graph::vertex_type &init_vertex, Stats &stats) {
+        auto result = tsp_bnb(init_vertex, tsp_budget::unlimited(), stats);
+        return std::make_pair(result.cost, result.tour);
+    }
+
+    inline tsp_result directed_graph::tsp_bnb(const directed_graph::vertex_type &init_vertex, tsp_budget budget) {
+        tsp_no_stats stats;
+        return tsp_bnb(init_vertex, budget, stats);
+    }
+
+    template <class Stats>
+    tsp_result directed_graph::tsp_bnb(const directed_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        const size_type n = vertices_size();
+        tsp_result result;
+
+        stats.start();
+        warm_start(init_vertex, budget, result);
+
+        atsp_state state;
+        state.path = ds::array_list<vertex_type>(n + 1);
+        state.path.push_back(init_vertex);
+        state.visited = ds::array_list<bool>(n, false);
+        state.visited[init_vertex] = true;
+        state.cost = 0;
+        state.nodes = 0;
+        state.nearest = nearest_successors();
+        state.assignment = make_assignment(init_vertex);
+
+        /* the root is the only full solve, every other node repairs its parent */
+        long long root_bound = 0;
+        if (n > 1) {
+            stats.begin_bound();
+            for (size_type i = 1; i <= n; ++i) {
+                augment(state.assignment, static_cast<int>(i));
+            }
+            root_bound = assignment_value(state.assignment);
+            stats.end_bound();
+        }
+
+        if (root_bound >= FORBIDDEN) {
+            /* not even an assignment exists, so there is no tour */
+            stats.on_prune();
+            result.lower_bound = result.cost;
+        } else if (tsp_bnb_search(state, root_bound, budget, result, stats)) {
+            result.lower_bound = result.cost;
+        }
+
+        stats.finish();
+
+        return result;
+    }
+
+    template <class Stats>
+    bool directed_graph::tsp_bnb_search(directed_graph::atsp_state &state, long long lower_bound,
+                                        const tsp_budget &budget, tsp_result &result, Stats &stats) {
+        const size_type n = vertices_size();
+        const vertex_type init_vertex = state.path[0];
+        const vertex_type last = state.path[state.path.size() - 1];
+        assignment_state &a = state.assignment;
+        weight_type &min_cost = result.cost;
+
+        result.status = budget.check(state.nodes);
+        if (result.status != tsp_status::optimal) {
+            /* Every unexplored tour is below this node or an open one above it */
+            result.lower_bound = static_cast<weight_type>(std::min<long long>(min_cost, lower_bound));
+            return false;
+        }
+
+        if (lower_bound >= min_cost) {
+            stats.on_prune();
+            return true;
+        }
+        ++state.nodes;
+        stats.on_expand(state.path.size());
+
+        if (state.path.size() == n) {
+            weight_type closing = cost_matrix[last][init_vertex];
+            if (n > 1 && closing == UNREACHABLE_VALUE) {
+                return true;
+            }
+            weight_type tc = state.cost + closing;
+
+            if (tc < min_cost) {
+                min_cost = tc;
+                result.tour = state.path;
+                result.tour.push_back(init_vertex);
+                stats.on_incumbent(min_cost);
+                budget.improved(min_cost, result.tour);
+            }
+            return true;
+        }
+
+        /****************************************************************
+         * The assignment is a single cycle through all vertices: it is
+         * a tour that extends the path, and no tour below is cheaper
+         ****************************************************************/
+        ds::array_list<vertex_type> successor(n, -1);
+        for (size_type j = 1; j <= n; ++j) {
+            successor[a.row[j] - 1] = static_cast<vertex_type>(j) - 1;
+        }
+        size_type length = 0;
+        vertex_type at = init_vertex;
+        do {
+            at = successor[at];
+            ++length;
+        } while (at != init_vertex);
+
+        if (length == n) {
+            ds::array_list<vertex_type> tour(n + 1);
+            tour.push_back(init_vertex);
+            for (vertex_type v = successor[init_vertex]; v != init_vertex; v = successor[v]) {
+                tour.push_back(v);
+            }
+            tour.push_back(init_vertex);
+
+            min_cost = static_cast<weight_type>(lower_bound);
+            result.tour = tour;
+            stats.on_incumbent(min_cost);
+            budget.improved(min_cost, result.tour);
+            return true;
+        }
+
+        /* The node stays open while its children are searched, it keeps a copy of its potentials */
+        const size_type width = n + 1;
+        const size_type depth = state.path.size() - 1;
+        const size_type bytes = sizeof(vertex_type) + width * (2 * sizeof(long long) + sizeof(int));
+        while (state.saved_row.size() < (depth + 1) * width) {
+            state.saved_u.push_back(0);
+            state.saved_v.push_back(0);
+            state.saved_row.push_back(0);
+        }
+        for (size_type j = 0; j < width; ++j) {
+            state.saved_u[depth * width + j] = a.u[j];
+            state.saved_v[depth * width + j] = a.v[j];
+            state.saved_row[depth * width + j] = a.row[j];
+        }
+        stats.on_push(state.path.size(), bytes);
+
+        /* the successor the assignment chose comes first, then the nearest ones */
+        const auto &nearest = state.nearest[last];
+        ds::array_list<vertex_type> children(nearest.size() + 1);
+        children.push_back(successor[last]);
+        for (size_type i = 0; i < nearest.size(); ++i) {
+            if (nearest[i] != successor[last]) {
+                children.push_back(nearest[i]);
+            }
+        }
+
+        bool finished = true;
+
+        for (size_type i = 0; i < children.size(); ++i) {
+            vertex_type vv = children[i];
+            if (state.visited[vv] || cost_matrix[last][vv] == UNREACHABLE_VALUE) {
+                continue;
+            }
+            if (lower_bound >= min_cost) {
+                break;
+            }
+            stats.on_generate();
+
+            /**********************************************************
+             * The potentials of this node stay feasible in the child,
+             * so fixing last -> vv costs at least its reduced cost
+             **********************************************************/
+            long long reduced = assignment_cost(a, last, vv) - a.u[last + 1] - a.v[vv + 1];
+            if (lower_bound + reduced >= min_cost) {
+                stats.on_prune();
+                continue;
+            }
+
+            /* extend */
+            state.path.push_back(vv);
+            state.visited[vv] = true;
+            state.cost += cost_matrix[last][vv];
+            vertex_type end = a.end;
+
+            long long child_bound = state.cost;
+            if (state.path.size() < n) {
+                stats.begin_bound();
+                fix_edge(a, last, vv);
+                child_bound = assignment_value(a);
+                stats.end_bound();
+            }
+
+            if (child_bound >= FORBIDDEN) {
+                stats.on_prune();
+            } else {
+                finished = tsp_bnb_search(state, child_bound, budget, result, stats);
+            }
+
+            /* undo */
+            a.succ[last] = -1;
+            a.pred[vv] = -1;
+            a.end = end;
+            for (size_type j = 0; j < width; ++j) {
+                a.u[j] = state.saved_u[depth * width + j];
+                a.v[j] = state.saved_v[depth * width + j];
+                a.row[j] = state.saved_row[depth * width + j];
+            }
+            state.cost -= cost_matrix[last][vv];
+            state.visited[vv] = false;
+            state.path.pop_back();
+
+            if (!finished) {
+                result.lower_bound = static_cast<weight_type>(std::min<long long>(result.lower_bound, lower_bound));
+                break;
+            }
+        }
+
+        stats.on_pop(bytes);
+        return finished;
+    }
+}
+
+#endif
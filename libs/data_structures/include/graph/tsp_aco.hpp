@@ -0,0 +1,498 @@
+/*****************************************************************
+ * Ant colony optimization for medium size tsp instances
+ * MAX-MIN ant system: every iteration the ants build tours in
+ * parallel from a shared pheromone table, optionally improve them
+ * with 2-opt, and only the best tour so far deposits pheromone.
+ * Pheromone is kept within [tau_min, tau_max] so the colony never
+ * settles on a single tour.
+ *
+ * An ant at vertex i only chooses among the candidates of i, its
+ * nearest neighbours. Pheromone is kept for candidate edges only.
+ * When every candidate is visited the ant moves to the nearest
+ * unvisited vertex.
+ *
+ * Every ant has its own random stream seeded from (seed, iteration,
+ * ant), so a solve is reproducible whatever the number of threads.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_ACO_HPP
+#define TSP_ACO_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_stats.hpp"
+#include "array_list.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+
+namespace ds {
+    struct tsp_aco_params {
+        typedef std::size_t size_type;
+
+        /* ants per iteration, 0 means one per vertex up to 32 */
+        size_type ants = 0;
+        /* 0 means until the budget stops the search */
+        size_type iterations = 200;
+        /* nearest neighbours an ant chooses from */
+        size_type candidates = 15;
+        /* weight of the pheromone */
+        double alpha = 1.0;
+        /* weight of the inverse edge length */
+        double beta = 2.0;
+        /* evaporation rate */
+        double rho = 0.2;
+        /* improve every ant's tour with 2-opt */
+        bool two_opt = true;
+        /* worker threads, 0 means one per hardware thread, 1 runs on the calling thread */
+        size_type threads = 0;
+        std::uint64_t seed = 1;
+    };
+
+    /*************************************************************************
+     * @brief: flat copy of the cost matrix with nearest neighbour lists,
+     *         shared read only by the threads of a heuristic
+     *************************************************************************/
+    struct tsp_neighbor_matrix {
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+
+        size_type n = 0;
+        /* neighbours per vertex */
+        size_type k = 0;
+        /* weight of (i, j) at i * n + j */
+        ds::array_list<weight_type> weights;
+        /* the k nearest neighbours of i at i * k, nearest first */
+        ds::array_list<vertex_type> neighbors;
+
+        tsp_neighbor_matrix(undirected_graph &g, size_type t_k) : n(g.vertices_size()) {
+            k = std::min(t_k, n > 0 ? n - 1 : 0);
+            weights = ds::array_list<weight_type>(n * n, 0);
+            for (size_type i = 0; i < n; ++i) {
+                for (size_type j = 0; j < n; ++j) {
+                    weights[i * n + j] = g.edge_weight({static_cast<vertex_type>(i), static_cast<vertex_type>(j)});
+                }
+            }
+
+            neighbors = ds::array_list<vertex_type>(n * k, 0);
+            ds::array_list<vertex_type> row(n > 0 ? n - 1 : 0, 0);
+            for (size_type i = 0; i < n; ++i) {
+                for (size_type j = 0, c = 0; j < n; ++j) {
+                    if (j != i) {
+                        row[c++] = static_cast<vertex_type>(j);
+                    }
+                }
+                const weight_type *w = &weights[i * n];
+                std::partial_sort(row.begin(), row.begin() + k, row.end(), [w](vertex_type a, vertex_type b) {
+                    return w[a] < w[b] || (w[a] == w[b] && a < b);
+                });
+                for (size_type c = 0; c < k; ++c) {
+                    neighbors[i * k + c] = row[c];
+                }
+            }
+        }
+
+        weight_type operator()(vertex_type i, vertex_type j) const {
+            return weights[i * n + j];
+        }
+
+        const vertex_type* candidates(vertex_type i) const {
+            return &neighbors[i * k];
+        }
+
+        /* Cost of an open tour of every vertex, with the edge back to its front */
+        weight_type cycle_cost(const ds::array_list<vertex_type> &tour) const {
+            weight_type cost = (*this)(tour.back(), tour.front());
+            for (size_type i = 0; i + 1 < tour.size(); ++i) {
+                cost += (*this)(tour[i], tour[i + 1]);
+            }
+            return cost;
+        }
+    };
+
+    /*************************************************************************
+     * @brief: the workers of a heuristic, a thread_pool when it runs on
+     *         more than one thread. With one thread the tasks run right
+     *         away on the caller and no thread is started, e.g. when the
+     *         solve itself is a task of a server or batch pool
+     *************************************************************************/
+    class tsp_workers {
+    public:
+        typedef std::size_t size_type;
+
+        explicit tsp_workers(size_type threads) : m_pool(threads > 1 ? new ds::thread_pool(threads) : nullptr) {}
+
+        size_type size() const {
+            return m_pool ? m_pool->size() : 1;
+        }
+
+        template <typename F>
+        void submit(F f) {
+            if (m_pool) {
+                m_pool->submit(f);
+            } else {
+                f();
+            }
+        }
+
+        void wait_idle() {
+            if (m_pool) {
+                m_pool->wait_idle();
+            }
+        }
+
+    private:
+        std::unique_ptr<ds::thread_pool> m_pool;
+    };
+
+    /*************************************************************************
+     * @brief: 2-opt on an open tour of every vertex (the closing edge is
+     *         implied), only moves that add an edge to a neighbour list
+     *         are tried. A vertex whose moves all fail is not looked at
+     *         again until one of its tour edges changes
+     * @params:
+     *      m - weights and neighbour lists
+     *      tour - n vertices, improved in place
+     * @return:
+     *      weight_type - change of the tour cost, <= 0
+     *************************************************************************/
+    inline tsp_neighbor_matrix::weight_type tsp_two_opt_neighbors(const tsp_neighbor_matrix &m,
+                                                                  ds::array_list<tsp_neighbor_matrix::vertex_type> &tour) {
+        typedef tsp_neighbor_matrix::vertex_type vertex_type;
+        typedef tsp_neighbor_matrix::weight_type weight_type;
+
+        const int n = static_cast<int>(m.n);
+        if (n < 5) {
+            return 0;
+        }
+
+        ds::array_list<int> position(n, 0);
+        for (int i = 0; i < n; ++i) {
+            position[tour[i]] = i;
+        }
+
+        /* reverse tour[i..j] going forward around the cycle, the shorter side is turned */
+        auto reverse = [&](int i, int j) {
+            int length = (j - i + n) % n + 1;
+            if (2 * length > n) {
+                int from = (j + 1) % n;
+                j = (i + n - 1) % n;
+                i = from;
+                length = n - length;
+            }
+            for (int s = 0; s < length / 2; ++s) {
+                std::swap(tour[i], tour[j]);
+                position[tour[i]] = i;
+                position[tour[j]] = j;
+                i = (i + 1) % n;
+                j = (j + n - 1) % n;
+            }
+        };
+
+        ds::array_list<vertex_type> queue(n, 0);
+        ds::array_list<bool> queued(n, true);
+        int head = 0, size = n;
+        for (int i = 0; i < n; ++i) {
+            queue[i] = tour[i];
+        }
+        auto enqueue = [&](vertex_type v) {
+            if (!queued[v]) {
+                queued[v] = true;
+                queue[(head + size++) % n] = v;
+            }
+        };
+
+        weight_type total = 0;
+        while (size > 0) {
+            vertex_type a = queue[head];
+            head = (head + 1) % n;
+            --size;
+            queued[a] = false;
+
+            bool improved = false;
+            for (int side = 0; side < 2 && !improved; ++side) {
+                /* side 0: edges (a, succ a) and (c, succ c), side 1: (pred a, a) and (pred c, c) */
+                int step = side == 0 ? 1 : n - 1;
+                vertex_type b = tour[(position[a] + step) % n];
+                weight_type ab = m(a, b);
+
+                const vertex_type *cands = m.candidates(a);
+                for (std::size_t ci = 0; ci < m.k; ++ci) {
+                    vertex_type c = cands[ci];
+                    weight_type ac = m(a, c);
+                    if (ac >= ab) {
+                        break;
+                    }
+                    vertex_type d = tour[(position[c] + step) % n];
+                    if (c == b || d == a) {
+                        continue;
+                    }
+
+                    weight_type delta = ac + m(b, d) - ab - m(c, d);
+                    if (delta >= 0) {
+                        continue;
+                    }
+
+                    if (side == 0) {
+                        reverse(position[b], position[c]);
+                    } else {
+                        reverse(position[a], position[d]);
+                    }
+                    total += delta;
+                    enqueue(a);
+                    enqueue(b);
+                    enqueue(c);
+                    enqueue(d);
+                    improved = true;
+                    break;
+                }
+            }
+        }
+
+        return total;
+    }
+
+    /*************************************************************************
+     * @brief: solve tsp by ant colony optimization
+     * @params:
+     *      g - the graph
+     *      init_vertex - vertex the tour starts at
+     *      params - colony size, pheromone weights, threads, see above
+     *      budget - limits, callback and stop token, one node per ant
+     *          tour, the deadline is checked after every iteration
+     *      stats - statistics policy, see tsp_stats.hpp
+     * @return:
+     *      tsp_result - tsp_status::heuristic after params.iterations,
+     *          otherwise the limit that stopped the colony. The lower
+     *          bound is the root bound of branch and bound
+     *************************************************************************/
+    template <class Stats>
+    tsp_result tsp_aco(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                       const tsp_aco_params &params, const tsp_budget &budget, Stats &stats) {
+        typedef undirected_graph::vertex_type vertex_type;
+        typedef undirected_graph::weight_type weight_type;
+        typedef undirected_graph::size_type size_type;
+
+        const size_type n = g.vertices_size();
+        if (n < 3) {
+            return g.tsp_bnb_v2(init_vertex, budget, stats);
+        }
+
+        tsp_result result;
+        result.status = tsp_status::heuristic;
+
+        stats.start();
+
+        tsp_neighbor_matrix m(g, params.candidates);
+        const size_type k = m.k;
+        const size_type ants = params.ants != 0 ? params.ants : std::min<size_type>(n, 32);
+
+        /* closed tour from init_vertex */
+        auto close = [&](const ds::array_list<vertex_type> &open) {
+            ds::array_list<vertex_type> closed(n + 1);
+            size_type start = std::find(open.cbegin(), open.cend(), init_vertex) - open.cbegin();
+            for (size_type i = 0; i < n; ++i) {
+                closed.push_back(open[(start + i) % n]);
+            }
+            closed.push_back(init_vertex);
+            return closed;
+        };
+        auto accept = [&](const ds::array_list<vertex_type> &open, weight_type cost) {
+            if (cost < result.cost) {
+                result.cost = cost;
+                result.tour = close(open);
+                stats.on_incumbent(result.cost);
+                budget.improved(result.cost, result.tour);
+            }
+        };
+
+        /* nearest neighbour tour sets the pheromone scale */
+        ds::array_list<vertex_type> nearest_tour;
+        {
+            ds::array_list<bool> visited(n, false);
+            vertex_type v = init_vertex;
+            for (size_type step = 0; step < n; ++step) {
+                nearest_tour.push_back(v);
+                visited[v] = true;
+                vertex_type next = -1;
+                for (vertex_type u = 0; u < static_cast<vertex_type>(n); ++u) {
+                    if (!visited[u] && (next == -1 || m(v, u) < m(v, next))) {
+                        next = u;
+                    }
+                }
+                v = next;
+            }
+        }
+
+        /* a valid warm start tour competes with the nearest neighbour tour */
+        const auto &initial = budget.initial_tour;
+        if (initial.size() == n + 1 && initial.front() == init_vertex && initial.back() == init_vertex) {
+            ds::array_list<vertex_type> warm(initial.cbegin(), initial.cend() - 1);
+            ds::array_list<bool> seen(n, false);
+            bool valid = true;
+            for (size_type i = 0; i < n && valid; ++i) {
+                valid = warm[i] >= 0 && warm[i] < static_cast<vertex_type>(n) && !seen[warm[i]];
+                if (valid) {
+                    seen[warm[i]] = true;
+                }
+            }
+            if (valid) {
+                accept(warm, m.cycle_cost(warm));
+            }
+        }
+        accept(nearest_tour, m.cycle_cost(nearest_tour));
+
+        ds::array_list<vertex_type> best_open(result.tour.begin(), result.tour.end() - 1);
+        auto bounds = [&](double &tau_min, double &tau_max) {
+            tau_max = 1.0 / (params.rho * std::max<weight_type>(result.cost, 1));
+            tau_min = tau_max / (2.0 * n);
+        };
+        double tau_min, tau_max;
+        bounds(tau_min, tau_max);
+
+        /* pheromone and choice weight of the c-th candidate of i at i * k + c */
+        ds::array_list<double> pheromone(n * k, tau_max);
+        ds::array_list<double> choice(n * k, 0.0);
+
+        ds::array_list<ds::array_list<vertex_type>> tours(ants, ds::array_list<vertex_type>(n, 0));
+        ds::array_list<weight_type> costs(ants, 0);
+
+        /* Ant a of iteration it builds tours[a] */
+        auto build = [&](size_type it, size_type a) {
+            std::mt19937_64 rng(params.seed * 0x9e3779b97f4a7c15ULL + it * ants + a);
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+            auto &tour = tours[a];
+            ds::array_list<bool> visited(n, false);
+            vertex_type v = static_cast<vertex_type>(rng() % n);
+
+            for (size_type step = 0; step < n; ++step) {
+                tour[step] = v;
+                visited[v] = true;
+                if (step + 1 == n) {
+                    break;
+                }
+
+                const vertex_type *cands = m.candidates(v);
+                double total = 0.0;
+                for (size_type c = 0; c < k; ++c) {
+                    if (!visited[cands[c]]) {
+                        total += choice[v * k + c];
+                    }
+                }
+
+                vertex_type next = -1;
+                if (total > 0.0) {
+                    double r = uniform(rng) * total;
+                    for (size_type c = 0; c < k; ++c) {
+                        if (visited[cands[c]]) {
+                            continue;
+                        }
+                        next = cands[c];
+                        r -= choice[v * k + c];
+                        if (r <= 0.0) {
+                            break;
+                        }
+                    }
+                } else {
+                    for (vertex_type u = 0; u < static_cast<vertex_type>(n); ++u) {
+                        if (!visited[u] && (next == -1 || m(v, u) < m(v, next))) {
+                            next = u;
+                        }
+                    }
+                }
+                v = next;
+            }
+
+            if (params.two_opt) {
+                tsp_two_opt_neighbors(m, tour);
+            }
+            costs[a] = m.cycle_cost(tour);
+        };
+
+        const size_type threads = std::min(params.threads != 0 ? params.threads
+            : std::max<size_type>(std::thread::hardware_concurrency(), 1), ants);
+        tsp_workers pool(threads);
+
+        size_type nodes = 0;
+        for (size_type it = 0; params.iterations == 0 || it < params.iterations; ++it) {
+            auto status = budget.check(nodes);
+            if (status == tsp_status::optimal && budget.past_deadline()) {
+                status = tsp_status::time_limit;
+            }
+            if (status != tsp_status::optimal) {
+                result.status = status;
+                break;
+            }
+
+            for (size_type i = 0; i < n * k; ++i) {
+                weight_type w = std::max<weight_type>(m.weights[(i / k) * n + m.neighbors[i]], 1);
+                choice[i] = std::pow(pheromone[i], params.alpha) * std::pow(1.0 / w, params.beta);
+            }
+
+            /* ants are split into one contiguous chunk per thread */
+            size_type chunk = (ants + threads - 1) / threads;
+            for (size_type first = 0; first < ants; first += chunk) {
+                size_type last = std::min(first + chunk, ants);
+                pool.submit([&build, it, first, last]() {
+                    for (size_type a = first; a < last; ++a) {
+                        build(it, a);
+                    }
+                });
+            }
+            pool.wait_idle();
+
+            for (size_type a = 0; a < ants; ++a) {
+                ++nodes;
+                stats.on_expand(n);
+                if (costs[a] < result.cost) {
+                    accept(tours[a], costs[a]);
+                    best_open = tours[a];
+                    bounds(tau_min, tau_max);
+                }
+            }
+
+            /* evaporate, then the best tour so far deposits on its edges */
+            for (size_type i = 0; i < n * k; ++i) {
+                pheromone[i] = std::max(pheromone[i] * (1.0 - params.rho), tau_min);
+            }
+            double deposit = 1.0 / std::max<weight_type>(result.cost, 1);
+            for (size_type i = 0; i < n; ++i) {
+                vertex_type from = best_open[i], to = best_open[(i + 1) % n];
+                for (int side = 0; side < 2; ++side) {
+                    const vertex_type *cands = m.candidates(from);
+                    for (size_type c = 0; c < k; ++c) {
+                        if (cands[c] == to) {
+                            pheromone[from * k + c] = std::min(pheromone[from * k + c] + deposit, tau_max);
+                            break;
+                        }
+                    }
+                    std::swap(from, to);
+                }
+            }
+        }
+
+        result.lower_bound = std::min(result.cost, g.tsp_bnb_lower_bound_v2({init_vertex}));
+        if (result.status == tsp_status::heuristic && result.lower_bound == result.cost) {
+            result.status = tsp_status::optimal;
+        }
+
+        stats.finish();
+
+        return result;
+    }
+
+    inline tsp_result tsp_aco(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                              const tsp_aco_params &params = tsp_aco_params(), const tsp_budget &budget = tsp_budget()) {
+        tsp_no_stats stats;
+        return tsp_aco(g, init_vertex, params, budget, stats);
+    }
+}
+
+#endif
@@ -0,0 +1,471 @@
+/*****************************************************************
+ * Multi-start parallel simulated annealing for tsp
+ * Every chain anneals its own copy of the tour on a worker thread
+ * with its own random stream. Chains run in epochs, after every
+ * exchange_interval epochs each chain restarts from the best tour
+ * found by any chain. More cores give more chains in the same
+ * wall time.
+ *
+ * Moves are 2-opt and or-opt (a segment of 1..3 vertices moved
+ * next to another vertex, possibly reversed). The second vertex of
+ * a move is taken from the neighbour list of the first, the cost
+ * change of a move is evaluated in O(1) from the cost matrix.
+ *
+ * The temperature falls geometrically from t0 to t0 * t_ratio. It
+ * follows the epochs, or the clock when the search runs until the
+ * deadline. An epoch based run is reproducible for a given seed and
+ * number of chains.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_ANNEAL_HPP
+#define TSP_ANNEAL_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_aco.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_stats.hpp"
+#include "array_list.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace ds {
+    struct tsp_anneal_params {
+        typedef std::size_t size_type;
+
+        /* independent chains, 0 means one per hardware thread */
+        size_type chains = 0;
+        /* worker threads, 0 means one per chain up to the hardware threads, 1 runs on the calling thread */
+        size_type threads = 0;
+        /* 0 means until the deadline, the temperature then follows the clock */
+        size_type epochs = 100;
+        /* moves per chain and epoch, 0 means 10 per vertex */
+        size_type moves_per_epoch = 0;
+        /* chains restart from the best tour every this many epochs, 0 never */
+        size_type exchange_interval = 10;
+        /* nearest neighbours the second vertex of a move is taken from */
+        size_type candidates = 10;
+        /* starting temperature, 0 means estimated from the start tour */
+        double t0 = 0.0;
+        /* final temperature over starting temperature */
+        double t_ratio = 1e-3;
+        std::uint64_t seed = 1;
+    };
+
+    /*************************************************************************
+     * @brief: one annealing chain, an open tour of every vertex with the
+     *         position of each vertex in it
+     *************************************************************************/
+    class tsp_anneal_chain {
+    public:
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+
+        tsp_anneal_chain(const tsp_neighbor_matrix &t_m, std::uint64_t seed)
+            : m_matrix(&t_m), m_rng(seed), m_cost(0) {}
+
+        /* Start from an open tour */
+        void reset(const ds::array_list<vertex_type> &t_tour, weight_type cost) {
+            m_tour = t_tour;
+            m_position = ds::array_list<int>(m_tour.size(), 0);
+            for (int i = 0; i < m_tour.size(); ++i) {
+                m_position[m_tour[i]] = i;
+            }
+            m_cost = cost;
+            m_best = m_tour;
+            m_best_cost = cost;
+        }
+
+        weight_type cost() const {
+            return m_cost;
+        }
+
+        weight_type best_cost() const {
+            return m_best_cost;
+        }
+
+        const ds::array_list<vertex_type>& best() const {
+            return m_best;
+        }
+
+        /* Mean cost increase of random uphill moves, scale for the temperature */
+        double uphill_mean(size_type samples) {
+            double total = 0.0;
+            size_type count = 0;
+            for (size_type s = 0; s < samples; ++s) {
+                weight_type delta = propose_two_opt();
+                if (delta > 0 && delta != NO_MOVE) {
+                    total += delta;
+                    ++count;
+                }
+            }
+            return count == 0 ? 1.0 : total / count;
+        }
+
+        /*********************************************************************
+         * @brief: run a number of moves at a fixed temperature
+         * @return: size_type - number of accepted moves
+         *********************************************************************/
+        size_type run(size_type moves, double temperature) {
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            size_type accepted = 0;
+
+            for (size_type i = 0; i < moves; ++i) {
+                bool or_opt = (m_rng() & 1) != 0;
+                weight_type delta = or_opt ? propose_or_opt() : propose_two_opt();
+                if (delta == NO_MOVE) {
+                    continue;
+                }
+                if (delta > 0 && uniform(m_rng) >= std::exp(-delta / temperature)) {
+                    continue;
+                }
+
+                if (or_opt) {
+                    apply_or_opt();
+                } else {
+                    apply_two_opt();
+                }
+                m_cost += delta;
+                ++accepted;
+
+                if (m_cost < m_best_cost) {
+                    m_best_cost = m_cost;
+                    m_best = m_tour;
+                }
+            }
+
+            return accepted;
+        }
+
+    private:
+        static constexpr weight_type NO_MOVE = std::numeric_limits<weight_type>::max();
+
+        int size() const {
+            return static_cast<int>(m_tour.size());
+        }
+
+        vertex_type at(int i) const {
+            int n = size();
+            return m_tour[((i % n) + n) % n];
+        }
+
+        vertex_type random_vertex() {
+            return static_cast<vertex_type>(m_rng() % m_tour.size());
+        }
+
+        vertex_type random_candidate(vertex_type a) {
+            return m_matrix->candidates(a)[m_rng() % m_matrix->k];
+        }
+
+        /* 2-opt: edges (a, succ a) and (c, succ c) become (a, c) and (succ a, succ c) */
+        weight_type propose_two_opt() {
+            const auto &w = *m_matrix;
+            vertex_type a = random_vertex();
+            vertex_type c = random_candidate(a);
+            vertex_type b = at(m_position[a] + 1);
+            vertex_type d = at(m_position[c] + 1);
+            if (c == b || d == a) {
+                return NO_MOVE;
+            }
+            m_move[0] = a;
+            m_move[1] = b;
+            m_move[2] = c;
+            return w(a, c) + w(b, d) - w(a, b) - w(c, d);
+        }
+
+        void apply_two_opt() {
+            reverse(m_position[m_move[1]], m_position[m_move[2]]);
+        }
+
+        /******************************************************************
+         * or-opt: the segment s..e of 1..3 vertices from a random vertex
+         * is removed, p and q around it are joined, and it is put back
+         * between c and its successor, in the cheaper direction
+         ******************************************************************/
+        weight_type propose_or_opt() {
+            const auto &w = *m_matrix;
+            int n = size();
+            int length = 1 + static_cast<int>(m_rng() % 3);
+            if (n < length + 3) {
+                return NO_MOVE;
+            }
+
+            vertex_type s = random_vertex();
+            int i = m_position[s];
+            vertex_type e = at(i + length - 1);
+            vertex_type p = at(i - 1);
+            vertex_type q = at(i + length);
+
+            vertex_type c = random_candidate(s);
+            int offset = ((m_position[c] - i) % n + n) % n;
+            /* c inside the segment, or c = p which leaves the tour as it is */
+            if (offset < length || c == p) {
+                return NO_MOVE;
+            }
+            vertex_type f = at(m_position[c] + 1);
+
+            weight_type removed = w(p, s) + w(e, q) + w(c, f);
+            weight_type forward = w(c, s) + w(e, f);
+            weight_type backward = w(c, e) + w(s, f);
+
+            m_move[0] = s;
+            m_move[1] = length;
+            m_move[2] = c;
+            m_move[3] = backward < forward;
+            return w(p, q) + std::min(forward, backward) - removed;
+        }
+
+        void apply_or_opt() {
+            int n = size();
+            int i = m_position[m_move[0]];
+            int length = m_move[1];
+            vertex_type c = m_move[2];
+            bool reversed = m_move[3] != 0;
+
+            vertex_type segment[3];
+            for (int k = 0; k < length; ++k) {
+                segment[k] = at(i + k);
+            }
+
+            /* shift the vertices between the segment and c towards the gap */
+            int gap = ((m_position[c] - i) % n + n) % n - length + 1;
+            if (gap <= n / 2) {
+                /* c is ahead: q..c move back by length */
+                for (int k = 0; k < gap; ++k) {
+                    place(i + k, at(i + length + k));
+                }
+                for (int k = 0; k < length; ++k) {
+                    place(i + gap + k, segment[reversed ? length - 1 - k : k]);
+                }
+            } else {
+                /* c is behind: succ c..p move forward by length */
+                int back = n - length - gap;
+                for (int k = 1; k <= back; ++k) {
+                    place(i + length - k, at(i - k));
+                }
+                for (int k = 0; k < length; ++k) {
+                    place(i - back + k, segment[reversed ? length - 1 - k : k]);
+                }
+            }
+        }
+
+        void place(int i, vertex_type v) {
+            int n = size();
+            i = ((i % n) + n) % n;
+            m_tour[i] = v;
+            m_position[v] = i;
+        }
+
+        /* reverse tour[i..j] going forward around the cycle, the shorter side is turned */
+        void reverse(int i, int j) {
+            int n = size();
+            int length = (j - i + n) % n + 1;
+            if (2 * length > n) {
+                int from = (j + 1) % n;
+                j = (i + n - 1) % n;
+                i = from;
+                length = n - length;
+            }
+            for (int s = 0; s < length / 2; ++s) {
+                std::swap(m_tour[i], m_tour[j]);
+                m_position[m_tour[i]] = i;
+                m_position[m_tour[j]] = j;
+                i = (i + 1) % n;
+                j = (j + n - 1) % n;
+            }
+        }
+
+        const tsp_neighbor_matrix *m_matrix;
+        std::mt19937_64 m_rng;
+
+        ds::array_list<vertex_type> m_tour;
+        ds::array_list<int> m_position;
+        weight_type m_cost;
+
+        ds::array_list<vertex_type> m_best;
+        weight_type m_best_cost;
+
+        /* the last proposed move, see propose_two_opt and propose_or_opt */
+        int m_move[4];
+    };
+
+    /*************************************************************************
+     * @brief: solve tsp by parallel simulated annealing
+     * @params:
+     *      g - the graph
+     *      init_vertex - vertex the tour starts at
+     *      params - chains, schedule and exchange, see above
+     *      budget - limits, callback and stop token, one node per chain
+     *          and epoch, checked between epochs
+     *      stats - statistics policy, see tsp_stats.hpp
+     * @return:
+     *      tsp_result - tsp_status::heuristic after params.epochs, or when
+     *          a run until the deadline reaches it, otherwise the limit
+     *          that stopped it. The lower bound is the root bound of
+     *          branch and bound
+     *************************************************************************/
+    template <class Stats>
+    tsp_result tsp_anneal(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                          const tsp_anneal_params &params, const tsp_budget &budget, Stats &stats) {
+        typedef undirected_graph::vertex_type vertex_type;
+        typedef undirected_graph::weight_type weight_type;
+        typedef undirected_graph::size_type size_type;
+        typedef tsp_budget::clock clock;
+
+        const size_type n = g.vertices_size();
+        if (n < 5) {
+            return g.tsp_bnb_v2(init_vertex, budget, stats);
+        }
+
+        tsp_result result;
+        result.status = tsp_status::heuristic;
+
+        stats.start();
+        const auto started = clock::now();
+
+        tsp_neighbor_matrix m(g, params.candidates);
+
+        const size_type hardware = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        const size_type chains = params.chains != 0 ? params.chains : hardware;
+        const size_type threads = std::min(params.threads != 0 ? params.threads : hardware, chains);
+        const size_type moves = params.moves_per_epoch != 0 ? params.moves_per_epoch : 10 * n;
+        const bool until_deadline = params.epochs == 0 && budget.has_deadline();
+        const size_type epochs = params.epochs != 0 ? params.epochs : 100;
+
+        auto accept = [&](const ds::array_list<vertex_type> &open, weight_type cost) {
+            if (cost < result.cost) {
+                result.cost = cost;
+                result.tour = ds::array_list<vertex_type>(n + 1);
+                size_type start = std::find(open.cbegin(), open.cend(), init_vertex) - open.cbegin();
+                for (size_type i = 0; i < n; ++i) {
+                    result.tour.push_back(open[(start + i) % n]);
+                }
+                result.tour.push_back(init_vertex);
+                stats.on_incumbent(result.cost);
+                budget.improved(result.cost, result.tour);
+            }
+        };
+
+        /* the start tour: the warm start if it is valid, else nearest neighbour */
+        ds::array_list<vertex_type> start_tour;
+        const auto &initial = budget.initial_tour;
+        if (initial.size() == n + 1 && initial.front() == init_vertex && initial.back() == init_vertex) {
+            ds::array_list<bool> seen(n, false);
+            for (size_type i = 0; i < n; ++i) {
+                vertex_type v = initial[i];
+                if (v < 0 || v >= static_cast<vertex_type>(n) || seen[v]) {
+                    break;
+                }
+                seen[v] = true;
+                start_tour.push_back(v);
+            }
+            if (start_tour.size() != n) {
+                start_tour.clear();
+            }
+        }
+        if (start_tour.empty()) {
+            ds::array_list<bool> visited(n, false);
+            vertex_type v = init_vertex;
+            for (size_type step = 0; step < n; ++step) {
+                start_tour.push_back(v);
+                visited[v] = true;
+                vertex_type next = -1;
+                for (vertex_type u = 0; u < static_cast<vertex_type>(n); ++u) {
+                    if (!visited[u] && (next == -1 || m(v, u) < m(v, next))) {
+                        next = u;
+                    }
+                }
+                v = next;
+            }
+        }
+        accept(start_tour, m.cycle_cost(start_tour));
+
+        /* chain c draws from the stream of (seed, c) only */
+        ds::array_list<tsp_anneal_chain> chain_list(chains);
+        for (size_type c = 0; c < chains; ++c) {
+            chain_list.push_back(tsp_anneal_chain(m, params.seed * 0x9e3779b97f4a7c15ULL + c));
+            chain_list[c].reset(start_tour, result.cost);
+        }
+
+        double t0 = params.t0;
+        if (t0 <= 0.0) {
+            /* an average uphill move is accepted half of the time at the start */
+            tsp_anneal_chain probe(m, params.seed);
+            probe.reset(start_tour, result.cost);
+            t0 = probe.uphill_mean(1000) / std::log(2.0);
+        }
+
+        tsp_workers pool(threads);
+
+        size_type nodes = 0;
+        for (size_type epoch = 0; until_deadline || epoch < epochs; ++epoch) {
+            auto status = budget.check(nodes);
+            if (status == tsp_status::optimal && budget.past_deadline()) {
+                status = until_deadline ? tsp_status::heuristic : tsp_status::time_limit;
+            }
+            if (status != tsp_status::optimal) {
+                result.status = status;
+                break;
+            }
+
+            double progress = static_cast<double>(epoch) / epochs;
+            if (until_deadline) {
+                progress = std::chrono::duration<double>(clock::now() - started) /
+                           std::chrono::duration<double>(budget.deadline - started);
+            }
+            double temperature = t0 * std::pow(params.t_ratio, std::min(progress, 1.0));
+
+            /* chains are split into one contiguous chunk per thread */
+            size_type chunk = (chains + threads - 1) / threads;
+            for (size_type first = 0; first < chains; first += chunk) {
+                size_type last = std::min(first + chunk, chains);
+                pool.submit([&chain_list, first, last, moves, temperature]() {
+                    for (size_type c = first; c < last; ++c) {
+                        chain_list[c].run(moves, temperature);
+                    }
+                });
+            }
+            pool.wait_idle();
+
+            size_type leader = 0;
+            for (size_type c = 0; c < chains; ++c) {
+                ++nodes;
+                stats.on_expand(n);
+                if (chain_list[c].best_cost() < chain_list[leader].best_cost()) {
+                    leader = c;
+                }
+            }
+            accept(chain_list[leader].best(), chain_list[leader].best_cost());
+
+            if (params.exchange_interval != 0 && (epoch + 1) % params.exchange_interval == 0) {
+                auto best = chain_list[leader].best();
+                weight_type best_cost = chain_list[leader].best_cost();
+                for (size_type c = 0; c < chains; ++c) {
+                    chain_list[c].reset(best, best_cost);
+                }
+            }
+        }
+
+        result.lower_bound = std::min(result.cost, g.tsp_bnb_lower_bound_v2({init_vertex}));
+        if (result.status == tsp_status::heuristic && result.lower_bound == result.cost) {
+            result.status = tsp_status::optimal;
+        }
+
+        stats.finish();
+
+        return result;
+    }
+
+    inline tsp_result tsp_anneal(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                                 const tsp_anneal_params &params = tsp_anneal_params(), const tsp_budget &budget = tsp_budget()) {
+        tsp_no_stats stats;
+        return tsp_anneal(g, init_vertex, params, budget, stats);
+    }
+}
+
+#endif
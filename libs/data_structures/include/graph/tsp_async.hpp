@@ -0,0 +1,118 @@
+/*****************************************************************
+ * Asynchronous front end for the tsp solvers
+ * Each solve runs on its own thread on a copy of the graph and is
+ * stopped cooperatively through the stop token of its budget
+ *****************************************************************/
+#pragma once
+#ifndef TSP_ASYNC_HPP
+#define TSP_ASYNC_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_solver.hpp"
+
+#include <chrono>
+#include <future>
+#include <utility>
+
+namespace ds {
+    /* Handle to a running solve, move only */
+    class tsp_task {
+    public:
+        tsp_task() = default;
+
+        tsp_task(std::future<tsp_result> &&t_future, tsp_stop_source t_stop)
+            : m_future(std::move(t_future)), m_stop(std::move(t_stop)) {}
+
+        tsp_task(tsp_task &&) = default;
+
+        tsp_task& operator=(tsp_task &&other) {
+            if (this != &other) {
+                abandon();
+                m_future = std::move(other.m_future);
+                m_stop = std::move(other.m_stop);
+            }
+            return *this;
+        }
+
+        /* An abandoned task is cancelled, then waited for */
+        ~tsp_task() {
+            abandon();
+        }
+
+        /* false once get() was called or for a default constructed task */
+        bool valid() const {
+            return m_future.valid();
+        }
+
+        /* true if the result is available, never blocks */
+        bool ready() const {
+            return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+        }
+
+        void wait() const {
+            m_future.wait();
+        }
+
+        /* wait at most d, true if the result became available */
+        template <typename Rep, typename Period>
+        bool wait_for(const std::chrono::duration<Rep, Period> &d) const {
+            return m_future.wait_for(d) == std::future_status::ready;
+        }
+
+        /* ask the solver to stop, get() then returns its best tour with status cancelled */
+        void cancel() {
+            m_stop.request_stop();
+        }
+
+        bool cancel_requested() const {
+            return m_stop.stop_requested();
+        }
+
+        /* wait for and take the result, rethrows an exception thrown by the solver */
+        tsp_result get() {
+            return m_future.get();
+        }
+
+    private:
+        void abandon() {
+            if (m_future.valid()) {
+                m_stop.request_stop();
+                m_future.wait();
+            }
+        }
+
+        std::future<tsp_result> m_future;
+        tsp_stop_source m_stop;
+    };
+
+    /*************************************************************
+     * @brief: start a solve on a new thread
+     * @params:
+     *      g - copied, the caller may modify or destroy it
+     *      init_vertex - vertex to start at
+     *      solver - callable (undirected_graph &, const tsp_budget &) -> tsp_result
+     *      budget - its stop token is replaced by the task's own;
+     *               the improvement callback runs on the solver thread
+     *************************************************************/
+    template <typename Solver>
+    tsp_task tsp_solve_async(const undirected_graph &g, Solver solver, tsp_budget budget = tsp_budget()) {
+        tsp_stop_source stop;
+        budget.stop = stop.get_token();
+
+        auto future = std::async(std::launch::async, [graph = g, solver, budget]() mutable {
+            return solver(graph, budget);
+        });
+
+        return tsp_task(std::move(future), std::move(stop));
+    }
+
+    inline tsp_task tsp_solve_async(const undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                                    tsp_algorithm algorithm, tsp_budget budget = tsp_budget()) {
+        return tsp_solve_async(g, [init_vertex, algorithm](undirected_graph &graph, const tsp_budget &b) {
+            return tsp_solve(graph, init_vertex, algorithm, b);
+        }, std::move(budget));
+    }
+}
+
+#endif
@@ -0,0 +1,404 @@
+/*****************************************************************
+ * Lower bound policies for branch and bound on tsp
+ * The search grows one path from the start vertex and asks its
+ * policy for a lower bound of every tour that extends the path.
+ * A policy follows the path through
+ *
+ *      initialize(weights, start)  the path is the start vertex
+ *      extend(from, to)            the edge (from, to) is appended
+ *      retract(from, to)           the last edge is removed again
+ *      bound()                     lower bound of the current path,
+ *                                  max() if no tour extends it
+ *      child_bound(from, to)       cheap bound of the child through
+ *                                  (from, to), before it is extended
+ *
+ * Children are searched nearest first and the search stops at the
+ * first one whose child_bound reaches the incumbent, so child_bound
+ * must not decrease along increasing weights of (from, to). The
+ * parent bound always qualifies.
+ *
+ * Policies are template parameters of undirected_graph::tsp_bnb,
+ * the inner loop has no virtual calls.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_BOUND_HPP
+#define TSP_BOUND_HPP
+
+#include "array_list.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace ds {
+    /*****************************************************************
+     * Branch and bound only searches tours whose second vertex is
+     * below their last one. This follows a path in O(1) per step and
+     * tells when no tour of that orientation extends it: it is
+     * complete and ends below its second vertex, or every vertex
+     * above the second one is already on it
+     *****************************************************************/
+    class tsp_orientation {
+    public:
+        typedef std::size_t size_type;
+        typedef int vertex_type;
+
+        void initialize(size_type vertices, const vertex_type &start) {
+            m_vertices = vertices;
+            m_start = start;
+            m_size = 1;
+            m_second = -1;
+            m_last = start;
+            m_above = 0;
+        }
+
+        void extend(const vertex_type &to) {
+            if (++m_size == 2) {
+                m_second = to;
+                m_above = m_vertices - 1 - to - (m_start > to ? 1 : 0);
+            } else if (to > m_second) {
+                --m_above;
+            }
+            m_last = to;
+        }
+
+        void retract(const vertex_type &from, const vertex_type &to) {
+            if (m_size-- == 2) {
+                m_second = -1;
+                m_above = 0;
+            } else if (to > m_second) {
+                ++m_above;
+            }
+            m_last = from;
+        }
+
+        bool allowed() const {
+            if (m_vertices <= 2 || m_size < 2) {
+                return true;
+            }
+            return m_size == m_vertices ? m_last > m_second : m_above > 0;
+        }
+
+    private:
+        size_type m_vertices = 0;
+        vertex_type m_start = 0;
+        size_type m_size = 0;
+        vertex_type m_second = -1;
+        vertex_type m_last = 0;
+        /* vertices above the second one that are not on the path */
+        size_type m_above = 0;
+    };
+
+    /*****************************************************************
+     * Sum of the cheapest edge of every vertex the path has not left
+     * yet, plus the path cost. The last vertex of a tour leaves
+     * through the closing edge back to the start, once the path has
+     * an edge the cheapest such exchange is added. Only tours whose
+     * second vertex is below their last one are bounded, the other
+     * orientation of every tour gets max()
+     *****************************************************************/
+    class tsp_min_adjacent_bound {
+    public:
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+        typedef ds::array_list<ds::array_list<weight_type>> matrix;
+
+        void initialize(const matrix &weights, const vertex_type &start) {
+            const size_type n = weights.size();
+            m_weights = &weights;
+            m_min_adjacent = ds::array_list<weight_type>(n, std::numeric_limits<weight_type>::max());
+            m_in_path = ds::array_list<bool>(n, false);
+            m_path = ds::array_list<vertex_type>(n + 1);
+            m_base = 0;
+
+            for (size_type v = 0; v < n; ++v) {
+                for (size_type u = 0; u < n; ++u) {
+                    if (weights[v][u] != 0 && weights[v][u] < m_min_adjacent[v]) {
+                        m_min_adjacent[v] = weights[v][u];
+                    }
+                }
+                m_base += m_min_adjacent[v];
+            }
+
+            m_path.push_back(start);
+            m_in_path[start] = true;
+        }
+
+        void extend(const vertex_type &from, const vertex_type &to) {
+            m_base = child_bound(from, to);
+            m_path.push_back(to);
+            m_in_path[to] = true;
+        }
+
+        void retract(const vertex_type &from, const vertex_type &to) {
+            m_in_path[to] = false;
+            m_path.pop_back();
+            m_base = m_base + m_min_adjacent[from] - (*m_weights)[from][to];
+        }
+
+        weight_type bound() const {
+            if (m_path.size() == 1) {
+                return m_base;
+            }
+            weight_type closing = closing_bound();
+            return closing == std::numeric_limits<weight_type>::max() ? closing : m_base + closing;
+        }
+
+        /* Going from last to to trades the cheapest edge of last for the edge (last, to) */
+        weight_type child_bound(const vertex_type &from, const vertex_type &to) const {
+            return m_base - m_min_adjacent[from] + (*m_weights)[from][to];
+        }
+
+    private:
+        /* cheapest extra cost of closing the tour from an allowed last vertex */
+        weight_type closing_bound() const {
+            const matrix &w = *m_weights;
+            const vertex_type n = static_cast<vertex_type>(w.size());
+            const vertex_type start = m_path.front();
+            const vertex_type second = n > 2 ? m_path[1] : -1;
+
+            if (m_path.size() == w.size()) {
+                vertex_type last = m_path.back();
+                if (last <= second) {
+                    return std::numeric_limits<weight_type>::max();
+                }
+                return w[last][start] - m_min_adjacent[last];
+            }
+
+            weight_type best = std::numeric_limits<weight_type>::max();
+            for (vertex_type v = second + 1; v < n; ++v) {
+                if (!m_in_path[v]) {
+                    best = std::min(best, w[v][start] - m_min_adjacent[v]);
+                }
+            }
+            return best;
+        }
+
+        const matrix *m_weights = nullptr;
+        ds::array_list<weight_type> m_min_adjacent;
+        ds::array_list<bool> m_in_path;
+        ds::array_list<vertex_type> m_path;
+        /* path cost plus the cheapest edge of every vertex not left yet */
+        weight_type m_base = 0;
+    };
+
+    /*****************************************************************
+     * Every vertex of a tour has two edges. Half the sum over the
+     * vertices of their two cheapest edges is a lower bound, along
+     * the path the edges it fixed replace the cheapest ones: inner
+     * vertices count both path edges, the two ends their path edge
+     * and the cheapest of their other edges. O(1) per step
+     *****************************************************************/
+    class tsp_half_sum_bound {
+    public:
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+        typedef ds::array_list<ds::array_list<weight_type>> matrix;
+
+        void initialize(const matrix &weights, const vertex_type &start) {
+            const size_type n = weights.size();
+            const weight_type none = std::numeric_limits<weight_type>::max();
+            m_weights = &weights;
+            m_orientation.initialize(n, start);
+            m_first = ds::array_list<weight_type>(n, none);
+            m_second = ds::array_list<weight_type>(n, none);
+            m_path = ds::array_list<vertex_type>(n + 1);
+            m_path.push_back(start);
+            m_twice = 0;
+
+            for (size_type v = 0; v < n; ++v) {
+                for (size_type u = 0; u < n; ++u) {
+                    weight_type w = weights[v][u];
+                    if (u == v || w == 0) {
+                        continue;
+                    }
+                    if (w < m_first[v]) {
+                        m_second[v] = m_first[v];
+                        m_first[v] = w;
+                    } else if (w < m_second[v]) {
+                        m_second[v] = w;
+                    }
+                }
+                /* a vertex of a tour of two has the same edge twice */
+                if (m_second[v] == none) {
+                    m_second[v] = m_first[v];
+                }
+                m_twice += static_cast<long long>(m_first[v]) + m_second[v];
+            }
+        }
+
+        void extend(const vertex_type &from, const vertex_type &to) {
+            m_twice += step(from, to);
+            m_path.push_back(to);
+            m_orientation.extend(to);
+        }
+
+        void retract(const vertex_type &from, const vertex_type &to) {
+            m_orientation.retract(from, to);
+            m_path.pop_back();
+            m_twice -= step(from, to);
+        }
+
+        weight_type bound() const {
+            if (!m_orientation.allowed()) {
+                return std::numeric_limits<weight_type>::max();
+            }
+            return static_cast<weight_type>((m_twice + 1) / 2);
+        }
+
+        weight_type child_bound(const vertex_type &, const vertex_type &) const {
+            return bound();
+        }
+
+    private:
+        /* cheapest edge of v other than one of weight w */
+        weight_type other(const vertex_type &v, weight_type w) const {
+            return w == m_first[v] ? m_second[v] : m_first[v];
+        }
+
+        /* change of the doubled bound when the path, ending at from, grows by (from, to) */
+        long long step(const vertex_type &from, const vertex_type &to) const {
+            const matrix &w = *m_weights;
+            const weight_type edge = w[from][to];
+            long long change = 2LL * edge - m_first[to] - m_second[to] + other(to, edge);
+
+            if (m_path.size() == 1) {
+                /* the start trades its two cheapest edges for the path edge and another */
+                change -= m_first[from] + m_second[from] - other(from, edge);
+            } else {
+                /* from becomes an inner vertex, both its edges are on the path now */
+                change -= other(from, w[m_path[m_path.size() - 2]][from]);
+            }
+            return change;
+        }
+
+        const matrix *m_weights = nullptr;
+        tsp_orientation m_orientation;
+        ds::array_list<weight_type> m_first;
+        ds::array_list<weight_type> m_second;
+        ds::array_list<vertex_type> m_path;
+        /* twice the bound: path edges twice, the cheapest edges once */
+        long long m_twice = 0;
+    };
+
+    /*****************************************************************
+     * Reduced cost matrix bound of Little et al. The rest of the tour
+     * leaves the last vertex and every unvisited one once and enters
+     * every unvisited one and the start once. Subtracting the row
+     * minima, then the column minima of what is left, from those rows
+     * and columns gives a lower bound of its cost. O(n^2) per step,
+     * computed when the path is extended and kept per depth
+     *****************************************************************/
+    class tsp_reduced_cost_bound {
+    public:
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+        typedef ds::array_list<ds::array_list<weight_type>> matrix;
+
+        void initialize(const matrix &weights, const vertex_type &start) {
+            const size_type n = weights.size();
+            m_weights = &weights;
+            m_visited = ds::array_list<bool>(n, false);
+            m_visited[start] = true;
+            m_start = start;
+            m_orientation.initialize(n, start);
+            m_rows = ds::array_list<vertex_type>(n);
+            m_columns = ds::array_list<vertex_type>(n);
+            m_reduced = ds::array_list<weight_type>(n, 0);
+            m_cost = ds::array_list<weight_type>(n + 1);
+            m_bounds = ds::array_list<weight_type>(n + 1);
+            m_bounds.push_back(reduce(start, 0));
+        }
+
+        void extend(const vertex_type &from, const vertex_type &to) {
+            m_visited[to] = true;
+            weight_type cost = m_cost.empty() ? 0 : m_cost.back();
+            m_cost.push_back(cost + (*m_weights)[from][to]);
+            m_orientation.extend(to);
+            /* no need to reduce for a path that is not searched */
+            m_bounds.push_back(m_orientation.allowed() ? reduce(to, m_cost.back()) : std::numeric_limits<weight_type>::max());
+        }
+
+        void retract(const vertex_type &from, const vertex_type &to) {
+            m_orientation.retract(from, to);
+            m_bounds.pop_back();
+            m_cost.pop_back();
+            m_visited[to] = false;
+        }
+
+        weight_type bound() const {
+            return m_bounds.back();
+        }
+
+        weight_type child_bound(const vertex_type &, const vertex_type &) const {
+            return bound();
+        }
+
+    private:
+        /* path cost plus the reduction of the rows and columns the rest of the tour uses */
+        weight_type reduce(const vertex_type &last, weight_type cost) {
+            const matrix &w = *m_weights;
+            const weight_type none = std::numeric_limits<weight_type>::max();
+            const vertex_type n = static_cast<vertex_type>(w.size());
+
+            m_rows.clear();
+            m_columns.clear();
+            m_rows.push_back(last);
+            for (vertex_type v = 0; v < n; ++v) {
+                if (!m_visited[v]) {
+                    m_rows.push_back(v);
+                    m_columns.push_back(v);
+                }
+            }
+            m_columns.push_back(m_start);
+
+            /* the start can only be entered from last when nothing is left */
+            const bool closing = m_columns.size() == 1;
+            long long total = cost;
+
+            for (size_type r = 0; r < m_rows.size(); ++r) {
+                const vertex_type from = m_rows[r];
+                weight_type least = none;
+                for (size_type c = 0; c < m_columns.size(); ++c) {
+                    const vertex_type to = m_columns[c];
+                    if (to != from && (closing || from != last || to != m_start)) {
+                        least = std::min(least, w[from][to]);
+                    }
+                }
+                m_reduced[from] = least;
+                total += least;
+            }
+
+            for (size_type c = 0; c < m_columns.size(); ++c) {
+                const vertex_type to = m_columns[c];
+                weight_type least = none;
+                for (size_type r = 0; r < m_rows.size(); ++r) {
+                    const vertex_type from = m_rows[r];
+                    if (to != from && (closing || from != last || to != m_start)) {
+                        least = std::min(least, w[from][to] - m_reduced[from]);
+                    }
+                }
+                total += least;
+            }
+
+            return static_cast<weight_type>(std::min<long long>(total, none));
+        }
+
+        const matrix *m_weights = nullptr;
+        ds::array_list<bool> m_visited;
+        vertex_type m_start = 0;
+        tsp_orientation m_orientation;
+        /* scratch rows, columns and row minima of reduce */
+        ds::array_list<vertex_type> m_rows;
+        ds::array_list<vertex_type> m_columns;
+        ds::array_list<weight_type> m_reduced;
+        /* path cost and bound per depth */
+        ds::array_list<weight_type> m_cost;
+        ds::array_list<weight_type> m_bounds;
+    };
+}
+
+#endif
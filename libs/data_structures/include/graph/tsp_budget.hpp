@@ -0,0 +1,202 @@
+/*****************************************************************
+ * Search budget and anytime result for the tsp solvers
+ * A solver stops when the deadline or the node limit is reached
+ * and returns the best tour found with a proven lower bound
+ *****************************************************************/
+#pragma once
+#ifndef TSP_BUDGET_HPP
+#define TSP_BUDGET_HPP
+
+#include "array_list.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+
+namespace ds {
+    /* Why a solver returned */
+    enum class tsp_status {
+        /* search finished, the tour is optimal */
+        optimal,
+        /* deadline reached */
+        time_limit,
+        /* node limit reached */
+        node_limit,
+        /* stop requested through a tsp_stop_token */
+        cancelled,
+        /* heuristic finished, the tour is good but not proven optimal */
+        heuristic
+    };
+
+    /* Name used in reports */
+    inline const char* tsp_status_name(tsp_status status) {
+        switch (status) {
+            case tsp_status::optimal: return "optimal";
+            case tsp_status::time_limit: return "time_limit";
+            case tsp_status::node_limit: return "node_limit";
+            case tsp_status::cancelled: return "cancelled";
+            case tsp_status::heuristic: return "heuristic";
+        }
+        return "";
+    }
+
+    /*****************************************************************
+     * Cooperative cancellation, a small stand-in for C++20 stop_token
+     * Tokens are cheap to copy and share the flag of their source
+     *****************************************************************/
+    class tsp_stop_token {
+    public:
+        /* A token that can never be stopped */
+        tsp_stop_token() = default;
+
+        explicit tsp_stop_token(std::shared_ptr<std::atomic<bool>> t_flag) : m_flag(std::move(t_flag)) {}
+
+        bool stop_requested() const noexcept {
+            return m_flag != nullptr && m_flag->load(std::memory_order_relaxed);
+        }
+
+        bool stop_possible() const noexcept {
+            return m_flag != nullptr;
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    class tsp_stop_source {
+    public:
+        tsp_stop_source() : m_flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+        tsp_stop_token get_token() const {
+            return tsp_stop_token(m_flag);
+        }
+
+        void request_stop() noexcept {
+            if (m_flag != nullptr) {
+                m_flag->store(true, std::memory_order_relaxed);
+            }
+        }
+
+        bool stop_requested() const noexcept {
+            return m_flag != nullptr && m_flag->load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_flag;
+    };
+
+    struct tsp_budget {
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+        typedef std::chrono::steady_clock clock;
+
+        /* Called with the cost and the tour on every incumbent improvement */
+        typedef std::function<void(weight_type, const ds::array_list<vertex_type> &)> callback_type;
+
+        /* The clock is read once every CHECK_INTERVAL nodes */
+        static constexpr size_type CHECK_INTERVAL = 1024;
+
+        clock::time_point deadline = clock::time_point::max();
+        size_type node_limit = std::numeric_limits<size_type>::max();
+        callback_type on_improvement;
+        /* checked on every node, one relaxed atomic load */
+        tsp_stop_token stop;
+        /* warm start: a known closed tour, used as the first incumbent */
+        ds::array_list<vertex_type> initial_tour;
+        /* branch and bound finishes nodes with fewer unvisited vertices
+           by dynamic programming, 0 turns it off */
+        size_type dp_threshold = 4;
+
+        /* No limit at all */
+        static tsp_budget unlimited() {
+            return tsp_budget();
+        }
+
+        /* Deadline at now + d */
+        template <typename Rep, typename Period>
+        static tsp_budget within(std::chrono::duration<Rep, Period> d) {
+            tsp_budget b;
+            b.deadline = clock::now() + std::chrono::duration_cast<clock::duration>(d);
+            return b;
+        }
+
+        /* At most n expanded nodes */
+        static tsp_budget nodes(size_type n) {
+            tsp_budget b;
+            b.node_limit = n;
+            return b;
+        }
+
+        bool has_deadline() const {
+            return deadline != clock::time_point::max();
+        }
+
+        /******************************************************
+         * @brief: check the budget before expanding a node
+         * @params: nodes - number of nodes expanded so far
+         * @return: tsp_status::optimal while budget remains,
+         *          otherwise the limit that was hit
+         ******************************************************/
+        tsp_status check(size_type nodes) const {
+            if (nodes >= node_limit) {
+                return tsp_status::node_limit;
+            }
+            if (stop.stop_requested()) {
+                return tsp_status::cancelled;
+            }
+            if (has_deadline() && nodes % CHECK_INTERVAL == 0 && clock::now() >= deadline) {
+                return tsp_status::time_limit;
+            }
+            return tsp_status::optimal;
+        }
+
+        /* Reads the clock now, for callers that just did a lot of work in one node */
+        bool past_deadline() const {
+            return has_deadline() && clock::now() >= deadline;
+        }
+
+        void improved(weight_type cost, const ds::array_list<vertex_type> &tour) const {
+            if (on_improvement) {
+                on_improvement(cost, tour);
+            }
+        }
+    };
+
+    /* Result of a budgeted solve */
+    struct tsp_result {
+        typedef int weight_type;
+        typedef int vertex_type;
+
+        /* cost of the best tour found, max() if none was found */
+        weight_type cost = std::numeric_limits<weight_type>::max();
+        ds::array_list<vertex_type> tour;
+        /* no tour is cheaper than this, equals cost when optimal */
+        weight_type lower_bound = 0;
+        tsp_status status = tsp_status::optimal;
+
+        bool optimal() const {
+            return status == tsp_status::optimal;
+        }
+
+        bool has_tour() const {
+            return !tour.empty();
+        }
+
+        /* Relative optimality gap (cost - lower_bound) / cost, 1 when no tour was found */
+        double gap() const {
+            if (!has_tour()) {
+                return 1.0;
+            }
+            if (cost == 0) {
+                return 0.0;
+            }
+            return static_cast<double>(cost - lower_bound) / cost;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,252 @@
+/*****************************************************************
+ * Cache of solved tsp instances
+ * Results are keyed by the fingerprint of the cost matrix and the
+ * start vertex and kept in a hash_table with LRU eviction. Evicted
+ * results can be spilled to a file and are read back on demand.
+ * Only optimal results are stored, a budgeted result is never
+ * served in place of a full solve.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_CACHE_HPP
+#define TSP_CACHE_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_budget.hpp"
+#include "hash_table.hpp"
+#include "linked_list.hpp"
+#include "array_list.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <mutex>
+
+namespace ds {
+    /* The key already is a good hash, use it as is */
+    struct tsp_cache_key_hash {
+        hash_value operator()(const std::uint64_t &key) const {
+            return static_cast<hash_value>(key);
+        }
+    };
+
+    class tsp_cache {
+    public:
+        typedef std::size_t size_type;
+        typedef std::uint64_t key_type;
+        typedef undirected_graph::vertex_type vertex_type;
+
+        /**************************************************************
+         * @params:
+         *      capacity - results kept in memory, at least 1
+         *      spill_path - file receiving evicted results, none if
+         *          empty. Results already in the file are available
+         *          right away and the results in memory are added
+         *          on destruction, so the file survives restarts
+         **************************************************************/
+        explicit tsp_cache(size_type capacity = 1024, const std::string &spill_path = "")
+            : m_capacity(capacity == 0 ? 1 : capacity), m_spill_path(spill_path) {
+            if (!m_spill_path.empty()) {
+                load_spill_index();
+            }
+        }
+
+        /* Spills the results still in memory so the next run finds them */
+        ~tsp_cache() {
+            for (auto it = m_lru.begin(); it != m_lru.end(); ++it) {
+                spill(*it, (*m_entries.find(*it)).second.result);
+            }
+        }
+
+        tsp_cache(const tsp_cache &) = delete;
+        tsp_cache& operator=(const tsp_cache &) = delete;
+
+        /* Key of the instance (g, start) */
+        static key_type key(const undirected_graph &g, const vertex_type &start) {
+            key_type h = g.fingerprint() ^ (static_cast<key_type>(start) + 0x9e3779b97f4a7c15ULL);
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return h ^ (h >> 31);
+        }
+
+        /****************************************************************
+         * @brief: look up a result, a hit becomes the most recently used
+         * @params: key - see key(), out - set to the stored result
+         * @return: false on a miss
+         ****************************************************************/
+        bool find(const key_type &key, tsp_result &out) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                auto &e = (*it).second;
+                m_lru.erase(e.lru);
+                m_lru.push_front(key);
+                e.lru = m_lru.begin();
+                out = e.result;
+                ++m_hits;
+                return true;
+            }
+
+            if (read_spilled(key, out)) {
+                store(key, out);
+                ++m_hits;
+                return true;
+            }
+
+            ++m_misses;
+            return false;
+        }
+
+        /* Store an optimal result, other results are ignored */
+        void insert(const key_type &key, const tsp_result &result) {
+            if (!result.optimal() || !result.has_tour()) {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_entries.contains(key)) {
+                return;
+            }
+            store(key, result);
+        }
+
+        /* Results held in memory */
+        size_type size() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_entries.size();
+        }
+
+        /* Results available from the spill file */
+        size_type spilled() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_spilled.size();
+        }
+
+        size_type capacity() const {
+            return m_capacity;
+        }
+
+        size_type hits() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_hits;
+        }
+
+        size_type misses() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_misses;
+        }
+
+    private:
+        typedef ds::linked_list<key_type> lru_list;
+
+        struct entry {
+            tsp_result result;
+            /* position in m_lru, front is the most recently used */
+            lru_list::iterator lru;
+        };
+
+        size_type m_capacity;
+        std::string m_spill_path;
+        size_type m_hits = 0;
+        size_type m_misses = 0;
+
+        ds::hash_table<key_type, entry, tsp_cache_key_hash> m_entries;
+        lru_list m_lru;
+        /* offset of the record of every spilled key */
+        ds::hash_table<key_type, std::streamoff, tsp_cache_key_hash> m_spilled;
+
+        std::mutex m_mutex;
+
+        /* Insert as most recently used, evicting the least recently used */
+        void store(const key_type &key, const tsp_result &result) {
+            if (m_entries.size() >= m_capacity) {
+                auto victim = m_lru.back();
+                auto it = m_entries.find(victim);
+                spill(victim, (*it).second.result);
+                m_entries.erase(victim);
+                m_lru.pop_back();
+            }
+
+            m_lru.push_front(key);
+            m_entries.insert(std::make_pair(key, entry{result, m_lru.begin()}));
+        }
+
+        /************************************************************
+         * One record per line:
+         *      key cost lower_bound tour_size v0 v1 ... vn
+         ************************************************************/
+        void spill(const key_type &key, const tsp_result &result) {
+            if (m_spill_path.empty() || m_spilled.contains(key)) {
+                return;
+            }
+
+            std::ofstream file(m_spill_path, std::ios::app);
+            if (!file.is_open()) {
+                return;
+            }
+            file.seekp(0, std::ios::end);
+            std::streamoff offset = file.tellp();
+
+            file << key << " " << result.cost << " " << result.lower_bound << " " << result.tour.size();
+            for (int i = 0; i < result.tour.size(); ++i) {
+                file << " " << result.tour[i];
+            }
+            file << "\n";
+
+            if (file) {
+                m_spilled.insert(std::make_pair(key, offset));
+            }
+        }
+
+        static bool parse_record(const std::string &line, key_type &key, tsp_result &result) {
+            std::istringstream is(line);
+            size_type tour_size;
+            if (!(is >> key >> result.cost >> result.lower_bound >> tour_size)) {
+                return false;
+            }
+
+            result.tour.clear();
+            for (size_type i = 0; i < tour_size; ++i) {
+                vertex_type v;
+                if (!(is >> v)) {
+                    return false;
+                }
+                result.tour.push_back(v);
+            }
+            result.status = tsp_status::optimal;
+            return true;
+        }
+
+        bool read_spilled(const key_type &key, tsp_result &out) {
+            auto it = m_spilled.find(key);
+            if (it == m_spilled.end()) {
+                return false;
+            }
+
+            std::ifstream file(m_spill_path);
+            file.seekg((*it).second);
+
+            std::string line;
+            key_type stored;
+            return std::getline(file, line) && parse_record(line, stored, out) && stored == key;
+        }
+
+        void load_spill_index() {
+            std::ifstream file(m_spill_path);
+            std::string line;
+            std::streamoff offset = 0;
+
+            while (std::getline(file, line)) {
+                key_type key;
+                tsp_result result;
+                if (parse_record(line, key, result) && !m_spilled.contains(key)) {
+                    m_spilled.insert(std::make_pair(key, offset));
+                }
+                offset += line.size() + 1;
+            }
+        }
+    };
+}
+
+#endif
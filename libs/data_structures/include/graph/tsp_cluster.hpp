@@ -0,0 +1,356 @@
+/*****************************************************************
+ * Cluster decomposition for very large tsp instances
+ * The vertices are split into k-medoids clusters on the cost
+ * matrix. Every cluster is solved on its own, in parallel: the
+ * fixed size dp when it is small enough, simulated annealing
+ * otherwise. The medoids are solved as a small tsp that gives
+ * the order of the clusters. Each cluster tour is then opened at
+ * the edge that joins it most cheaply to the previous cluster, and
+ * 2-opt repairs the tour around the joins.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_CLUSTER_HPP
+#define TSP_CLUSTER_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_anneal.hpp"
+#include "tsp_resolve.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_stats.hpp"
+#include "array_list.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace ds {
+    struct tsp_cluster_params {
+        typedef std::size_t size_type;
+
+        /* vertices per cluster the partition aims for */
+        size_type cluster_size = 200;
+        /* k-medoids rounds, fewer if the medoids stop moving */
+        size_type rounds = 5;
+        /* worker threads, 0 means one per hardware thread, 1 runs on the calling thread */
+        size_type threads = 0;
+        std::uint64_t seed = 1;
+    };
+
+    /* A partition of the vertices, cluster c is medoids[c] and its members */
+    struct tsp_clustering {
+        typedef int vertex_type;
+
+        ds::array_list<vertex_type> medoids;
+        ds::array_list<ds::array_list<vertex_type>> members;
+    };
+
+    /*************************************************************************
+     * @brief: k-medoids on the cost matrix. The medoids start by D^2
+     *         sampling, then every round assigns each vertex to its
+     *         nearest medoid and moves each medoid to the member with
+     *         the smallest total distance to the other members
+     * @params:
+     *      g - the graph
+     *      k - number of clusters, at most the number of vertices
+     *      rounds - rounds of assignment and update
+     *      seed - seed of the sampling
+     *      pool - workers for the assignment and the updates, a
+     *          ds::thread_pool or tsp_workers
+     * @return:
+     *      tsp_clustering - non empty clusters, at most k of them
+     *************************************************************************/
+    template <class Pool>
+    tsp_clustering tsp_k_medoids(undirected_graph &g, std::size_t k, std::size_t rounds, std::uint64_t seed, Pool &pool) {
+        typedef undirected_graph::vertex_type vertex_type;
+        typedef std::size_t size_type;
+
+        const size_type n = g.vertices_size();
+        k = std::max<size_type>(std::min(k, n), 1);
+        std::mt19937_64 rng(seed);
+
+        ds::array_list<vertex_type> medoids;
+        ds::array_list<double> distance(n, std::numeric_limits<double>::max());
+        vertex_type next = static_cast<vertex_type>(rng() % n);
+        while (medoids.size() < k) {
+            medoids.push_back(next);
+            double total = 0.0;
+            for (vertex_type v = 0; v < static_cast<vertex_type>(n); ++v) {
+                double d = g.edge_weight({v, next});
+                distance[v] = std::min(distance[v], d * d);
+                total += distance[v];
+            }
+            if (total <= 0.0) {
+                break;
+            }
+            double r = std::uniform_real_distribution<double>(0.0, total)(rng);
+            for (vertex_type v = 0; v < static_cast<vertex_type>(n); ++v) {
+                r -= distance[v];
+                if (r <= 0.0 || v + 1 == static_cast<vertex_type>(n)) {
+                    next = v;
+                    break;
+                }
+            }
+        }
+        k = medoids.size();
+
+        const size_type threads = pool.size();
+        ds::array_list<size_type> owner(n, 0);
+        tsp_clustering clustering;
+
+        for (size_type round = 0; round <= rounds; ++round) {
+            /* assign, one contiguous range of vertices per worker */
+            size_type chunk = (n + threads - 1) / threads;
+            for (size_type first = 0; first < n; first += chunk) {
+                size_type last = std::min(first + chunk, n);
+                pool.submit([&, first, last]() {
+                    for (size_type v = first; v < last; ++v) {
+                        size_type best = 0;
+                        for (size_type c = 1; c < k; ++c) {
+                            vertex_type u = static_cast<vertex_type>(v);
+                            if (g.edge_weight({u, medoids[c]}) < g.edge_weight({u, medoids[best]})) {
+                                best = c;
+                            }
+                        }
+                        owner[v] = best;
+                    }
+                });
+            }
+            pool.wait_idle();
+
+            clustering.members = ds::array_list<ds::array_list<vertex_type>>(k, ds::array_list<vertex_type>());
+            for (size_type v = 0; v < n; ++v) {
+                clustering.members[owner[v]].push_back(static_cast<vertex_type>(v));
+            }
+            if (round == rounds) {
+                break;
+            }
+
+            /* update, the member closest to all others becomes the medoid */
+            ds::array_list<vertex_type> moved(medoids);
+            for (size_type c = 0; c < k; ++c) {
+                pool.submit([&, c]() {
+                    const auto &cluster = clustering.members[c];
+                    long long best = std::numeric_limits<long long>::max();
+                    for (size_type i = 0; i < cluster.size(); ++i) {
+                        long long total = 0;
+                        for (size_type j = 0; j < cluster.size() && total < best; ++j) {
+                            total += g.edge_weight({cluster[i], cluster[j]});
+                        }
+                        if (total < best) {
+                            best = total;
+                            moved[c] = cluster[i];
+                        }
+                    }
+                });
+            }
+            pool.wait_idle();
+
+            bool changed = false;
+            for (size_type c = 0; c < k; ++c) {
+                changed = changed || moved[c] != medoids[c];
+            }
+            medoids = moved;
+            if (!changed) {
+                break;
+            }
+        }
+
+        for (size_type c = 0; c < k; ++c) {
+            if (!clustering.members[c].empty()) {
+                clustering.medoids.push_back(medoids[c]);
+            }
+        }
+        ds::array_list<ds::array_list<vertex_type>> members;
+        for (size_type c = 0; c < k; ++c) {
+            if (!clustering.members[c].empty()) {
+                members.push_back(clustering.members[c]);
+            }
+        }
+        clustering.members = members;
+
+        return clustering;
+    }
+
+    /*************************************************************************
+     * @brief: best tour of the sub graph on some vertices, with the
+     *         fixed size dp up to SMALL_TSP_MAX_VERTICES and one annealing
+     *         chain above. Falls back to the given order when the budget
+     *         stops the solver before it has a tour
+     * @return:
+     *      ds::array_list<vertex_type> - the vertices as an open tour
+     *************************************************************************/
+    inline ds::array_list<undirected_graph::vertex_type> tsp_cluster_tour(undirected_graph &g,
+            const ds::array_list<undirected_graph::vertex_type> &vertices, const tsp_budget &budget) {
+        typedef undirected_graph::vertex_type vertex_type;
+
+        const std::size_t s = vertices.size();
+        if (s < 4) {
+            return vertices;
+        }
+
+        undirected_graph::matrix m(s, ds::array_list<undirected_graph::weight_type>(s, 0));
+        for (std::size_t i = 0; i < s; ++i) {
+            for (std::size_t j = 0; j < s; ++j) {
+                m[i][j] = g.edge_weight({vertices[i], vertices[j]});
+            }
+        }
+        undirected_graph sub(m);
+
+        tsp_result solved;
+        if (s <= undirected_graph::SMALL_TSP_MAX_VERTICES) {
+            solved = sub.tsp_small(0, budget);
+        } else {
+            tsp_anneal_params params;
+            params.chains = 1;
+            params.threads = 1;
+            solved = tsp_anneal(sub, 0, params, budget);
+        }
+        if (!solved.has_tour()) {
+            return vertices;
+        }
+
+        ds::array_list<vertex_type> tour(s);
+        for (std::size_t i = 0; i < s; ++i) {
+            tour.push_back(vertices[solved.tour[i]]);
+        }
+        return tour;
+    }
+
+    /*************************************************************************
+     * @brief: solve tsp by cluster decomposition
+     * @params:
+     *      g - the graph
+     *      init_vertex - vertex the tour starts at
+     *      params - cluster size, k-medoids rounds, threads, see above
+     *      budget - the deadline and stop token reach every cluster
+     *          solve, the final 2-opt repair counts one node per queued
+     *          vertex
+     *      stats - statistics policy, see tsp_stats.hpp. The total time
+     *          covers the whole solve, every cluster solve counts as one
+     *          expanded node next to the nodes of the repair
+     * @return:
+     *      tsp_result - as returned by the repair, tsp_status::heuristic
+     *          unless a limit was hit
+     *************************************************************************/
+    template <class Stats>
+    tsp_result tsp_cluster_solve(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                                 const tsp_cluster_params &params, const tsp_budget &budget, Stats &stats) {
+        typedef undirected_graph::vertex_type vertex_type;
+        typedef undirected_graph::weight_type weight_type;
+        typedef undirected_graph::size_type size_type;
+
+        const size_type n = g.vertices_size();
+        if (n < 5) {
+            return g.tsp_bnb_v2(init_vertex, budget, stats);
+        }
+
+        stats.start();
+
+        tsp_workers pool(params.threads != 0 ? params.threads : std::max<size_type>(std::thread::hardware_concurrency(), 1));
+
+        size_type target = std::max<size_type>(params.cluster_size, 1);
+        auto clustering = tsp_k_medoids(g, (n + target - 1) / target, params.rounds, params.seed, pool);
+        const size_type k = clustering.medoids.size();
+
+        /* the cluster solves see the deadline and the stop token only */
+        tsp_budget inner;
+        inner.deadline = budget.deadline;
+        inner.stop = budget.stop;
+
+        ds::array_list<ds::array_list<vertex_type>> tours(k, ds::array_list<vertex_type>());
+        for (size_type c = 0; c < k; ++c) {
+            pool.submit([&, c]() {
+                tours[c] = tsp_cluster_tour(g, clustering.members[c], inner);
+            });
+        }
+        auto order = tsp_cluster_tour(g, clustering.medoids, inner);
+        pool.wait_idle();
+        for (size_type c = 0; c < k; ++c) {
+            stats.on_expand(clustering.members[c].size());
+        }
+        stats.on_expand(k);
+
+        /* order holds medoids, find the cluster of each */
+        ds::array_list<size_type> sequence;
+        for (size_type i = 0; i < k; ++i) {
+            for (size_type c = 0; c < k; ++c) {
+                if (clustering.medoids[c] == order[i]) {
+                    sequence.push_back(c);
+                    break;
+                }
+            }
+        }
+
+        /************************************************************
+         * Stitch: the first cluster is opened at its dearest edge,
+         * every next one at the vertex and direction that add the
+         * least to the join with the previous exit
+         ************************************************************/
+        ds::array_list<vertex_type> open(n);
+        ds::array_list<vertex_type> focus;
+        for (size_type i = 0; i < k; ++i) {
+            const auto &cycle = tours[sequence[i]];
+            const int s = static_cast<int>(cycle.size());
+            auto at = [&cycle, s](int j) { return cycle[((j % s) + s) % s]; };
+
+            int entry = 0;
+            int step = 1;
+            if (i == 0) {
+                weight_type dearest = std::numeric_limits<weight_type>::min();
+                for (int j = 0; j < s; ++j) {
+                    weight_type w = g.edge_weight({at(j - 1), at(j)});
+                    if (s > 1 && w > dearest) {
+                        dearest = w;
+                        entry = j;
+                    }
+                }
+            } else {
+                vertex_type exit = open.back();
+                long long best = std::numeric_limits<long long>::max();
+                for (int j = 0; j < s; ++j) {
+                    for (int direction : {1, -1}) {
+                        long long delta = g.edge_weight({exit, at(j)});
+                        if (s > 1) {
+                            delta -= g.edge_weight({at(j), at(j - direction)});
+                        }
+                        if (delta < best) {
+                            best = delta;
+                            entry = j;
+                            step = direction;
+                        }
+                    }
+                }
+            }
+
+            focus.push_back(at(entry));
+            for (int j = 0; j < s; ++j) {
+                open.push_back(at(entry + j * step));
+            }
+            focus.push_back(open.back());
+        }
+
+        size_type start = std::find(open.cbegin(), open.cend(), init_vertex) - open.cbegin();
+        ds::array_list<vertex_type> tour(n + 1);
+        for (size_type i = 0; i < n; ++i) {
+            tour.push_back(open[(start + i) % n]);
+        }
+        tour.push_back(init_vertex);
+
+        tsp_nested_stats<Stats> repair_stats(stats);
+        auto result = tsp_two_opt_repair(g, tour, focus, budget, repair_stats);
+
+        stats.finish();
+
+        return result;
+    }
+
+    inline tsp_result tsp_cluster_solve(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                                        const tsp_cluster_params &params = tsp_cluster_params(), const tsp_budget &budget = tsp_budget()) {
+        tsp_no_stats stats;
+        return tsp_cluster_solve(g, init_vertex, params, budget, stats);
+    }
+}
+
+#endif
@@ -0,0 +1,189 @@
+/*****************************************************************
+ * Re-optimization after a few edge weights changed
+ * The previous tour is repaired with 2-opt moves around the
+ * endpoints of the changed edges. The exact mode then starts
+ * branch and bound with the repaired tour as its incumbent,
+ * so most of the tree is pruned from the first node on.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_RESOLVE_HPP
+#define TSP_RESOLVE_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_stats.hpp"
+#include "linked_list.hpp"
+#include "array_list.hpp"
+
+#include <algorithm>
+
+namespace ds {
+    enum class tsp_resolve_mode {
+        /* branch and bound warm started from the repaired tour */
+        exact,
+        /* local 2-opt repair only */
+        repair
+    };
+
+    /*************************************************************************
+     * @brief: 2-opt local search limited to the neighbourhood of some
+     *         vertices. Both tour edges of a queued vertex are tried
+     *         against every other edge, the endpoints of an improving
+     *         move are queued again until no move improves the tour
+     * @params:
+     *      g - the graph
+     *      tour - closed tour, front() == back() stays in place
+     *      focus - vertices to start from, e.g. endpoints of changed edges
+     *      budget - limits and stop token, one node per queued vertex
+     *      stats - statistics policy, see tsp_stats.hpp
+     * @return:
+     *      tsp_result - tsp_status::heuristic unless a limit was hit or
+     *          the tour meets the root lower bound (tsp_status::optimal)
+     *************************************************************************/
+    template <class Stats>
+    tsp_result tsp_two_opt_repair(undirected_graph &g, const ds::array_list<undirected_graph::vertex_type> &tour,
+                                  const ds::array_list<undirected_graph::vertex_type> &focus, const tsp_budget &budget, Stats &stats) {
+        typedef undirected_graph::vertex_type vertex_type;
+        typedef undirected_graph::weight_type weight_type;
+        typedef undirected_graph::size_type size_type;
+
+        tsp_result result;
+        result.tour = tour;
+        result.status = tsp_status::heuristic;
+        auto &t = result.tour;
+
+        stats.start();
+
+        const int n = static_cast<int>(t.size()) - 1;
+        ds::array_list<int> position(g.vertices_size(), 0);
+        result.cost = 0;
+        for (int i = 0; i < n; ++i) {
+            position[t[i]] = i;
+            result.cost += g.edge_weight({t[i], t[i + 1]});
+        }
+
+        ds::linked_list<vertex_type> queue;
+        ds::array_list<bool> queued(g.vertices_size(), false);
+        auto enqueue = [&](vertex_type v) {
+            if (!queued[v]) {
+                queued[v] = true;
+                queue.push_back(v);
+            }
+        };
+        for (int i = 0; i < focus.size(); ++i) {
+            enqueue(focus[i]);
+        }
+
+        size_type nodes = 0;
+        while (!queue.empty() && n > 3) {
+            auto status = budget.check(nodes);
+            if (status != tsp_status::optimal) {
+                result.status = status;
+                break;
+            }
+            ++nodes;
+
+            vertex_type v = queue.front();
+            queue.pop_front();
+            queued[v] = false;
+            stats.on_expand(0);
+
+            bool improved = false;
+            for (int side = 0; side < 2 && !improved; ++side) {
+                /* the tour edges (t[p], t[p + 1]) at v */
+                int p = side == 0 ? (position[v] + n - 1) % n : position[v];
+
+                for (int q = 0; q < n && !improved; ++q) {
+                    if (q == p || q == (p + 1) % n || p == (q + 1) % n) {
+                        continue;
+                    }
+                    stats.on_generate();
+
+                    vertex_type a = t[p], b = t[p + 1], c = t[q], d = t[q + 1];
+                    weight_type delta = g.edge_weight({a, c}) + g.edge_weight({b, d})
+                        - g.edge_weight({a, b}) - g.edge_weight({c, d});
+                    if (delta >= 0) {
+                        continue;
+                    }
+
+                    /* reverse t[from..to], index 0 and n are never touched */
+                    for (int from = std::min(p, q) + 1, to = std::max(p, q); from < to; ++from, --to) {
+                        std::swap(t[from], t[to]);
+                        position[t[from]] = from;
+                        position[t[to]] = to;
+                    }
+
+                    result.cost += delta;
+                    stats.on_incumbent(result.cost);
+                    budget.improved(result.cost, result.tour);
+
+                    enqueue(a);
+                    enqueue(b);
+                    enqueue(c);
+                    enqueue(d);
+                    improved = true;
+                }
+            }
+        }
+
+        result.lower_bound = std::min(result.cost, g.tsp_bnb_lower_bound_v2({t[0]}));
+        if (result.status == tsp_status::heuristic && result.lower_bound == result.cost) {
+            result.status = tsp_status::optimal;
+        }
+
+        stats.finish();
+
+        return result;
+    }
+
+    /*************************************************************************
+     * @brief: re-solve after the weights of some edges changed, see
+     *         undirected_graph::set_edge_weight
+     * @params:
+     *      g - the graph with the new weights
+     *      previous - result on the old weights, its tour is the start
+     *      changed - edges whose weight changed
+     *      mode - tsp_resolve_mode::exact or tsp_resolve_mode::repair
+     *      budget - limits of the search, in exact mode the node limit
+     *          is shared by the repair and the branch and bound after it
+     *      stats - statistics policy of the final search
+     * @return:
+     *      tsp_result - as returned by branch and bound or by the repair.
+     *          Without a previous tour this is a cold branch and bound
+     *************************************************************************/
+    template <class Stats>
+    tsp_result tsp_resolve(undirected_graph &g, const tsp_result &previous,
+                           const ds::array_list<undirected_graph::edge_type> &changed,
+                           tsp_resolve_mode mode, tsp_budget budget, Stats &stats) {
+        if (previous.tour.size() != g.vertices_size() + 1) {
+            return g.tsp_bnb_v2(previous.tour.empty() ? 0 : previous.tour[0], budget, stats);
+        }
+
+        ds::array_list<undirected_graph::vertex_type> focus;
+        for (int i = 0; i < changed.size(); ++i) {
+            focus.push_back(changed[i].first);
+            focus.push_back(changed[i].second);
+        }
+
+        if (mode == tsp_resolve_mode::repair) {
+            return tsp_two_opt_repair(g, previous.tour, focus, budget, stats);
+        }
+
+        tsp_stats repair_stats;
+        auto repaired = tsp_two_opt_repair(g, previous.tour, focus, budget, repair_stats);
+        budget.initial_tour = repaired.tour;
+        /* the node limit covers both phases, branch and bound gets what the repair left */
+        budget.node_limit -= std::min(repair_stats.nodes_expanded, budget.node_limit);
+
+        return g.tsp_bnb_v2(repaired.tour[0], budget, stats);
+    }
+
+    inline tsp_result tsp_resolve(undirected_graph &g, const tsp_result &previous,
+                                  const ds::array_list<undirected_graph::edge_type> &changed,
+                                  tsp_resolve_mode mode, const tsp_budget &budget = tsp_budget()) {
+        tsp_no_stats stats;
+        return tsp_resolve(g, previous, changed, mode, budget, stats);
+    }
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*****************************************************************
+ * Runtime selection of the tsp solvers of undirected_graph
+ * Front ends (bench, async, batch) pick a solver by name through
+ * this header instead of keeping their own tables
+ *****************************************************************/
+#pragma once
+#ifndef TSP_SOLVER_HPP
+#define TSP_SOLVER_HPP
+
+#include "undirected_graph.hpp"
+#include "tsp_aco.hpp"
+#include "tsp_anneal.hpp"
+#include "tsp_cluster.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_stats.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace ds {
+    enum class tsp_algorithm {
+        brute_force,
+        branch_and_bound,
+        /* fixed size dp up to SMALL_TSP_MAX_VERTICES, branch and bound above */
+        small,
+        /* ant colony with default tsp_aco_params, not exact */
+        ant_colony,
+        /* parallel simulated annealing with default tsp_anneal_params, not exact */
+        annealing,
+        /* k-medoids clusters solved in parallel and stitched, not exact */
+        cluster
+    };
+
+    /* Every algorithm, in the order they are listed to users */
+    constexpr tsp_algorithm tsp_algorithms[] = {
+        tsp_algorithm::brute_force,
+        tsp_algorithm::branch_and_bound,
+        tsp_algorithm::small,
+        tsp_algorithm::ant_colony,
+        tsp_algorithm::annealing,
+        tsp_algorithm::cluster
+    };
+
+    /* Short name used on the command line */
+    inline const char* tsp_algorithm_name(tsp_algorithm algorithm) {
+        switch (algorithm) {
+            case tsp_algorithm::brute_force: return "bf";
+            case tsp_algorithm::branch_and_bound: return "bnb";
+            case tsp_algorithm::small: return "small";
+            case tsp_algorithm::ant_colony: return "aco";
+            case tsp_algorithm::annealing: return "sa";
+            case tsp_algorithm::cluster: return "cluster";
+        }
+        return "";
+    }
+
+    /*************************************************************
+     * @brief: look up an algorithm by its short name
+     * @return: false if no algorithm has that name
+     *************************************************************/
+    inline bool tsp_algorithm_from_name(const std::string &name, tsp_algorithm &algorithm) {
+        for (const auto &a : tsp_algorithms) {
+            if (name == tsp_algorithm_name(a)) {
+                algorithm = a;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*************************************************************
+     * @brief: run the selected solver with a budget
+     * @params:
+     *      g - the graph
+     *      init_vertex - vertex to start at
+     *      algorithm - the solver
+     *      budget - limits, callback and stop token
+     *      stats - statistics policy, see tsp_stats.hpp
+     *      threads - workers of the parallel heuristics, 0 means one
+     *          per hardware thread. Callers that already run the solve
+     *          on a pool of their own pass 1, the heuristic then runs
+     *          on the calling thread and starts no threads
+     *************************************************************/
+    template <class Stats>
+    tsp_result tsp_solve(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                         tsp_algorithm algorithm, const tsp_budget &budget, Stats &stats, std::size_t threads = 0) {
+        tsp_aco_params aco;
+        tsp_anneal_params anneal;
+        tsp_cluster_params cluster;
+        aco.threads = anneal.threads = cluster.threads = threads;
+
+        switch (algorithm) {
+            case tsp_algorithm::brute_force: return g.tsp_brute_force(init_vertex, budget, stats);
+            case tsp_algorithm::branch_and_bound: return g.tsp_bnb_v2(init_vertex, budget, stats);
+            case tsp_algorithm::small: return g.tsp_small(init_vertex, budget, stats);
+            case tsp_algorithm::ant_colony: return tsp_aco(g, init_vertex, aco, budget, stats);
+            case tsp_algorithm::annealing: return tsp_anneal(g, init_vertex, anneal, budget, stats);
+            case tsp_algorithm::cluster: return tsp_cluster_solve(g, init_vertex, cluster, budget, stats);
+        }
+        return tsp_result();
+    }
+
+    inline tsp_result tsp_solve(undirected_graph &g, const undirected_graph::vertex_type &init_vertex,
+                                tsp_algorithm algorithm, const tsp_budget &budget = tsp_budget(), std::size_t threads = 0) {
+        tsp_no_stats stats;
+        return tsp_solve(g, init_vertex, algorithm, budget, stats, threads);
+    }
+}
+
+#endif
@@ -0,0 +1,184 @@
+/*****************************************************************
+ * Statistics policies for the tsp solvers of undirected_graph
+ * The solvers are templates over the policy, tsp_no_stats has
+ * only empty inline members so collection compiles away entirely
+ *****************************************************************/
+#pragma once
+#ifndef TSP_STATS_HPP
+#define TSP_STATS_HPP
+
+#include "array_list.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+
+namespace ds {
+    /* Policy that records nothing */
+    struct tsp_no_stats {
+        typedef std::size_t size_type;
+        typedef int weight_type;
+
+        static constexpr bool enabled = false;
+
+        void start() {}
+        void finish() {}
+
+        void on_generate() {}
+        void on_expand(size_type) {}
+        void on_prune() {}
+
+        void begin_bound() {}
+        void end_bound() {}
+
+        void on_incumbent(weight_type) {}
+
+        void on_push(size_type, size_type) {}
+        void on_pop(size_type) {}
+    };
+
+    /* Policy that counts search events and times the solver phases */
+    struct tsp_stats {
+        typedef std::size_t size_type;
+        typedef int weight_type;
+        typedef std::chrono::steady_clock clock;
+        typedef std::chrono::nanoseconds duration;
+
+        static constexpr bool enabled = true;
+
+        /* An improvement of the best tour found so far */
+        struct incumbent {
+            weight_type cost;
+            /* time since the solver started */
+            duration time;
+            /* nodes expanded when it was found */
+            size_type nodes_expanded;
+        };
+
+        /* nodes created as children of an expanded node */
+        size_type nodes_generated = 0;
+        /* nodes taken from the frontier and branched on */
+        size_type nodes_expanded = 0;
+        /* nodes taken from the frontier and discarded by their bound */
+        size_type nodes_pruned = 0;
+        size_type bound_evaluations = 0;
+
+        /* deepest partial tour, in vertices */
+        size_type max_depth = 0;
+        /* most nodes waiting in the frontier at once */
+        size_type max_frontier_size = 0;
+        /* most bytes held by the frontier at once */
+        size_type peak_frontier_bytes = 0;
+
+        ds::array_list<incumbent> incumbents;
+
+        /* per phase wall time, search includes bound */
+        duration total_time = duration::zero();
+        duration bound_time = duration::zero();
+
+        void start() {
+            m_start = clock::now();
+        }
+
+        void finish() {
+            total_time = clock::now() - m_start;
+        }
+
+        void on_generate() {
+            ++nodes_generated;
+        }
+
+        void on_expand(size_type depth) {
+            ++nodes_expanded;
+            if (depth > max_depth) {
+                max_depth = depth;
+            }
+        }
+
+        void on_prune() {
+            ++nodes_pruned;
+        }
+
+        void begin_bound() {
+            ++bound_evaluations;
+            m_bound_start = clock::now();
+        }
+
+        void end_bound() {
+            bound_time += clock::now() - m_bound_start;
+        }
+
+        void on_incumbent(weight_type cost) {
+            incumbents.push_back(incumbent{cost, clock::now() - m_start, nodes_expanded});
+        }
+
+        /* A node of the given size in bytes entered the frontier */
+        void on_push(size_type frontier_size, size_type bytes) {
+            m_frontier_bytes += bytes;
+            if (frontier_size > max_frontier_size) {
+                max_frontier_size = frontier_size;
+            }
+            if (m_frontier_bytes > peak_frontier_bytes) {
+                peak_frontier_bytes = m_frontier_bytes;
+            }
+        }
+
+        /* A node of the given size in bytes left the frontier */
+        void on_pop(size_type bytes) {
+            m_frontier_bytes -= bytes;
+        }
+
+        friend std::ostream& operator<<(std::ostream &os, const tsp_stats &s) {
+            os << "Nodes generated: " << s.nodes_generated << std::endl;
+            os << "Nodes expanded: " << s.nodes_expanded << std::endl;
+            os << "Nodes pruned: " << s.nodes_pruned << std::endl;
+            os << "Bound evaluations: " << s.bound_evaluations << std::endl;
+            os << "Max depth: " << s.max_depth << std::endl;
+            os << "Max frontier size: " << s.max_frontier_size << std::endl;
+            os << "Peak frontier memory: " << s.peak_frontier_bytes << " bytes" << std::endl;
+            os << "Incumbent improvements: " << s.incumbents.size() << std::endl;
+            os << "Total time: " << std::chrono::duration_cast<std::chrono::microseconds>(s.total_time).count() << " us" << std::endl;
+            os << "Bound time: " << std::chrono::duration_cast<std::chrono::microseconds>(s.bound_time).count() << " us" << std::endl;
+            return os;
+        }
+
+    private:
+        clock::time_point m_start;
+        clock::time_point m_bound_start;
+        size_type m_frontier_bytes = 0;
+    };
+
+    /**********************************************************************
+     * Policy that hands the events of a solver run inside another one to
+     * the outer policy. start and finish belong to the outer solver, so
+     * the total time covers all of its phases and not only the last one
+     **********************************************************************/
+    template <class Stats>
+    struct tsp_nested_stats {
+        typedef typename Stats::size_type size_type;
+        typedef typename Stats::weight_type weight_type;
+
+        static constexpr bool enabled = Stats::enabled;
+
+        explicit tsp_nested_stats(Stats &t_outer) : outer(t_outer) {}
+
+        void start() {}
+        void finish() {}
+
+        void on_generate() { outer.on_generate(); }
+        void on_expand(size_type depth) { outer.on_expand(depth); }
+        void on_prune() { outer.on_prune(); }
+
+        void begin_bound() { outer.begin_bound(); }
+        void end_bound() { outer.end_bound(); }
+
+        void on_incumbent(weight_type cost) { outer.on_incumbent(cost); }
+
+        void on_push(size_type frontier_size, size_type bytes) { outer.on_push(frontier_size, bytes); }
+        void on_pop(size_type bytes) { outer.on_pop(bytes); }
+
+        Stats &outer;
+    };
+}
+
+#endif
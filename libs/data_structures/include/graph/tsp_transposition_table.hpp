@@ -0,0 +1,127 @@
+/*****************************************************************
+ * Transposition table for branch and bound on tsp
+ * A search state is the set of visited vertices and the current
+ * vertex, every completion of a state costs the same whatever
+ * order the prefix took. The table keeps the cheapest prefix seen
+ * per state, a later prefix that is not cheaper is dominated.
+ *
+ * The table has a fixed number of buckets with two entries each:
+ * the first keeps the shallowest state (it guards the largest
+ * subtree), the second is always replaced by the newest state.
+ * Losing an entry only loses pruning, never correctness.
+ *
+ * Branch and bound only searches tours whose second vertex is
+ * below their last one, a prefix with a larger second vertex has
+ * fewer completions. A recorded prefix dominates a new one only if
+ * it is no more expensive and its second vertex is no larger.
+ *****************************************************************/
+#pragma once
+#ifndef TSP_TRANSPOSITION_TABLE_HPP
+#define TSP_TRANSPOSITION_TABLE_HPP
+
+#include "array_list.hpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace ds {
+    class tsp_transposition_table {
+    public:
+        typedef std::size_t size_type;
+        typedef std::uint64_t mask_type;
+        typedef int weight_type;
+        typedef int vertex_type;
+
+        /* Visited sets are bit masks, larger graphs get no table */
+        static constexpr size_type MAX_VERTICES = 64;
+        static constexpr size_type MAX_BUCKET_BITS = 16;
+
+        /* An empty table that records nothing */
+        tsp_transposition_table() : m_mask(0) {}
+
+        /*****************************************************************
+         * @params: vertices - size of the graph, bucket_bits - log2 of
+         *          the number of buckets, capped by MAX_BUCKET_BITS
+         *****************************************************************/
+        tsp_transposition_table(size_type vertices, size_type bucket_bits) : m_mask(0) {
+            if (vertices < 4 || vertices > MAX_VERTICES) {
+                return;
+            }
+            size_type buckets = size_type(1) << std::min(bucket_bits, MAX_BUCKET_BITS);
+            m_entries = ds::array_list<entry>(2 * buckets, entry());
+            m_mask = buckets - 1;
+        }
+
+        /* Table sized for a graph, a few buckets per vertex subset up to the cap */
+        static tsp_transposition_table for_graph(size_type vertices) {
+            return tsp_transposition_table(vertices, vertices + 2);
+        }
+
+        bool enabled() const {
+            return !m_entries.empty();
+        }
+
+        /*****************************************************************
+         * @brief: record a prefix unless a cheaper one reached the state
+         * @params:
+         *      visited - bit mask of the vertices of the prefix
+         *      current - last vertex of the prefix
+         *      cost - cost of the prefix
+         *      depth - number of vertices in the prefix
+         *      second - second vertex of the prefix
+         * @return: false if the prefix is dominated and can be pruned
+         *****************************************************************/
+        bool improve(mask_type visited, vertex_type current, weight_type cost, size_type depth, vertex_type second = 0) {
+            if (!enabled()) {
+                return true;
+            }
+
+            size_type bucket = 2 * (hash(visited, current) & m_mask);
+            entry &deep = m_entries[bucket];
+            entry &recent = m_entries[bucket + 1];
+
+            for (entry *e : {&deep, &recent}) {
+                if (e->used && e->visited == visited && e->current == current) {
+                    if (e->cost <= cost && e->second <= second) {
+                        return false;
+                    }
+                    e->cost = cost;
+                    e->second = second;
+                    return true;
+                }
+            }
+
+            entry fresh{visited, cost, current, second, static_cast<std::uint32_t>(depth), true};
+            if (!deep.used || depth <= deep.depth) {
+                recent = deep;
+                deep = fresh;
+            } else {
+                recent = fresh;
+            }
+            return true;
+        }
+
+    private:
+        struct entry {
+            mask_type visited = 0;
+            weight_type cost = 0;
+            vertex_type current = 0;
+            vertex_type second = 0;
+            std::uint32_t depth = 0;
+            bool used = false;
+        };
+
+        static size_type hash(mask_type visited, vertex_type current) {
+            std::uint64_t h = visited * 0x9e3779b97f4a7c15ULL + static_cast<std::uint64_t>(current);
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return static_cast<size_type>(h ^ (h >> 31));
+        }
+
+        ds::array_list<entry> m_entries;
+        size_type m_mask;
+    };
+}
+
+#endif
@@ -4,15 +4,30 @@
 
 #include "array_list.hpp"
 #include "sort.hpp"
-
+#include "tsp_stats.hpp"
+#include "tsp_budget.hpp"
+#include "tsp_transposition_table.hpp"
+#include "tsp_bound.hpp"
+#include "thread_pool.hpp"
+#include "indexed_priority_queue.hpp"
+#include "radix_heap.hpp"
+
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <utility>
 #include <ostream>
 #include <iostream>
 #include <unordered_map>
 #include <limits>
+#include <memory>
 #include <algorithm>
 #include <iomanip>
+#include <thread>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 /* Implementation of graph using adjacency matrix */
 
@@ -34,17 +49,32 @@ namespace ds {
         /* typedef for the return type of tsp procedure */
         typedef std::pair<weight_type, ds::array_list<vertex_type>> tsp_return_type;
 
-        /* typedef for the return type of mst procedure*/
-        typedef std::pair<bool, undirected_graph> mst_return_type;
-
-        /* typedef for the return type of one tree procedure */
-        typedef std::pair<bool, undirected_graph> one_tree_return_type;
-
         /* definition of edge_type */
         typedef std::pair<vertex_type, vertex_type> edge_type;
+
+        /* typedef for next hops: row i, column j holds the vertex after i on the way to j */
+        typedef ds::array_list<ds::array_list<vertex_type>> next_hop_matrix;
+
+        /* typedef for the return type of shortest paths procedures: distance and parent of every vertex */
+        typedef std::pair<ds::array_list<weight_type>, ds::array_list<vertex_type>> shortest_paths_return_type;
+
+        /* Sparse adjacency, the edges of v are at offsets[v] .. offsets[v + 1] of targets and weights */
+        struct adjacency_type {
+            ds::array_list<size_type> offsets;
+            ds::array_list<vertex_type> targets;
+            ds::array_list<weight_type> weights;
+        };
+
+        /* typedef for the return type of mst procedure: weight and parent of every vertex */
+        typedef std::pair<weight_type, ds::array_list<vertex_type>> mst_return_type;
+
+        /* typedef for the return type of one tree procedure: weight and edges */
+        typedef std::pair<weight_type, ds::array_list<edge_type>> one_tree_return_type;
         
 
-        undirected_graph() : cost_matrix(matrix()), vertices(ds::array_list<vertex_type>()) {}
+        undirected_graph() : cost_matrix(matrix()), vertices(ds::array_list<vertex_type>()) {
+            rebuild_statistics();
+        }
 
 
         /**********************************************************************
@@ -57,16 +87,20 @@ namespace ds {
             for (int i = 0; i < cm.size(); ++i) {
                 vertices.push_back(i);
             }
+            rebuild_statistics();
         }
 
         /**********************************
          * @brief: Copy constructor
          * @param: other - undirected_graph 
          **********************************/
-        undirected_graph(const undirected_graph &other) : cost_matrix(other.cost_matrix), vertices(other.vertices) {}
+        undirected_graph(const undirected_graph &other) : cost_matrix(other.cost_matrix), vertices(other.vertices),
+            edges(other.edges), degrees(other.degrees), min_adjacent(other.min_adjacent),
+            second_min_adjacent(other.second_min_adjacent), min_edge(other.min_edge) {}
 
         void set_cost_matrix(matrix new_matrix) {
             cost_matrix = new_matrix;
+            rebuild_statistics();
         }
 
         /*************************************
@@ -74,46 +108,32 @@ namespace ds {
          *************************************/
         undirected_graph& operator=(const undirected_graph &other) {
             cost_matrix = other.cost_matrix;
+            edges = other.edges;
+            degrees = other.degrees;
+            min_adjacent = other.min_adjacent;
+            second_min_adjacent = other.second_min_adjacent;
+            min_edge = other.min_edge;
             return *this;
         }
 
         /********************************************
-         * @brief: Get number of edges in the graph
+         * @brief: Get number of edges in the graph,
+         *         kept up to date by set_edge_weight
          * @return: 
          *        size_type - denotes number of edges 
          ********************************************/
         size_type edges_size() const {
-            size_type count = 0;
-            auto copy = cost_matrix;
-
-            for (int i = 0; i < vertices_size(); ++i) {
-                for (int j = i + 1; j < vertices_size(); ++j) {
-                    if (copy[i][j] != UNREACHABLE_VALUE) {
-                        count++;
-                    }
-                }
-            }
-            return count;
+            return edges;
         }
 
         /*********************************************************
          * @brief: Get the weight of the minimum edge in the graph 
          * @return: 
-         *      weight_type - the minimum weight
+         *      weight_type - the minimum weight, max() if the
+         *          graph has no edge
          *********************************************************/
-        weight_type min_edge_weight() {
-            weight_type min = std::numeric_limits<weight_type>::max();
-
-            for (vertex_type i = 0; i < vertices_size(); ++i) {
-                for (vertex_type j = i + 1; j < vertices_size(); ++j) {
-                    weight_type curr = edge_weight({i, j});
-                    if (curr < min) {
-                        min = curr;
-                    }
-                }
-            }
-
-            return min;
+        weight_type min_edge_weight() const {
+            return min_edge;
         }
 
         /*************************************************************
@@ -121,14 +141,8 @@ namespace ds {
          * @param: vertex_type v 
          * @return: size_type - denotes the degree of the input vertex
          *************************************************************/
-        size_type vertex_degree(const vertex_type &v) {
-            size_type count = 0;
-            for (const auto &c : cost_matrix[v]) {
-                if (c != 0) {
-                    count++;
-                }
-            }
-            return count;
+        size_type vertex_degree(const vertex_type &v) const {
+            return degrees[v];
         }
 
         /****************************************************************************************
@@ -149,6 +163,26 @@ namespace ds {
             return ret;
         }
 
+        /*************************************************
+         * @brief: Set the weight of an edge, both
+         *         directions since the graph is undirected.
+         *         The edge count, the degrees and the
+         *         cheapest edges are updated in place, a
+         *         row is only rescanned when one of its two
+         *         cheapest edges gets dearer or is removed
+         * @params: edge_type e, weight_type weight
+         *************************************************/
+        void set_edge_weight(edge_type e, weight_type weight);
+
+        /*************************************************
+         * @brief: Remove an edge, same as setting its
+         *         weight to UNREACHABLE_VALUE
+         * @params: edge_type e
+         *************************************************/
+        void remove_edge(edge_type e) {
+            set_edge_weight(e, UNREACHABLE_VALUE);
+        }
+
         /*************************************************
          * @brief: Get edge weight of an edge
          * @params: edge_type e 
@@ -169,6 +203,27 @@ namespace ds {
             return cost_matrix.size();
         }
         
+        /******************************************************************
+         * @brief: 64-bit hash of the cost matrix, equal matrices give
+         *         equal fingerprints, used as the key of tsp_cache
+         * @return: std::uint64_t - the fingerprint
+         ******************************************************************/
+        std::uint64_t fingerprint() const {
+            std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ vertices_size();
+
+            for (size_type i = 0; i < vertices_size(); ++i) {
+                for (size_type j = 0; j < vertices_size(); ++j) {
+                    h = (h ^ static_cast<std::uint32_t>(cost_matrix[i][j])) * 0x100000001b3ULL;
+                    h ^= h >> 29;
+                }
+            }
+
+            /* final avalanche of splitmix64 */
+            h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+            return h ^ (h >> 31);
+        }
+
         /*******************************************
          * @brief: Overload << operator for printing
          *******************************************/
@@ -188,14 +243,68 @@ namespace ds {
          * @brief: Solve tsp problem by brute force
          * @params:
          *      vertex_type: vertex to start at
+         *      tsp_budget: time / node limits, the
+         *          improvement callback and an optional
+         *          warm start tour, see tsp_budget.hpp
+         *      Stats: statistics policy filled in by the
+         *          search, see tsp_stats.hpp
          * @return:
          *      tsp_return_type:
          *          the min cost of the tour
          *          the tour itself
+         *      tsp_result (budgeted overloads):
+         *          the best tour found, a proven lower
+         *          bound and why the search stopped
          ******************************************/
         tsp_return_type tsp_brute_force(const vertex_type &);
+        template <class Stats>
+        tsp_return_type tsp_brute_force(const vertex_type &, Stats &);
+        /* budget by value so an lvalue budget never binds to Stats & */
+        tsp_result tsp_brute_force(const vertex_type &, tsp_budget);
+        template <class Stats>
+        tsp_result tsp_brute_force(const vertex_type &, const tsp_budget &, Stats &);
+
         weight_type tsp_bnb_lower_bound_v2(ds::array_list<vertex_type> );
+
+        /*******************************************
+         * @brief: Solve tsp problem by branch and 
+         *         bound, same overloads as above
+         ******************************************/
         tsp_return_type tsp_bnb_v2(const vertex_type &);
+        template <class Stats>
+        tsp_return_type tsp_bnb_v2(const vertex_type &, Stats &);
+        tsp_result tsp_bnb_v2(const vertex_type &, tsp_budget);
+        template <class Stats>
+        tsp_result tsp_bnb_v2(const vertex_type &, const tsp_budget &, Stats &);
+
+        /*******************************************
+         * @brief: Solve tsp problem by branch and
+         *         bound with the lower bound policy
+         *         Bound, see tsp_bound.hpp. tsp_bnb_v2
+         *         is tsp_bnb<tsp_min_adjacent_bound>
+         ******************************************/
+        template <class Bound>
+        tsp_result tsp_bnb(const vertex_type &, tsp_budget = tsp_budget());
+        template <class Bound, class Stats>
+        tsp_result tsp_bnb(const vertex_type &, const tsp_budget &, Stats &);
+
+        /* Largest graph solved by the fixed size dp of tsp_small */
+        static constexpr size_type SMALL_TSP_MAX_VERTICES = 16;
+
+        /*******************************************
+         * @brief: Solve small tsp problems by a dp
+         *         compiled for the exact number of
+         *         vertices, graphs with more than
+         *         SMALL_TSP_MAX_VERTICES fall back to
+         *         tsp_bnb_v2, same overloads as above.
+         *         The node limit counts dp subsets
+         ******************************************/
+        tsp_return_type tsp_small(const vertex_type &);
+        template <class Stats>
+        tsp_return_type tsp_small(const vertex_type &, Stats &);
+        tsp_result tsp_small(const vertex_type &, tsp_budget);
+        template <class Stats>
+        tsp_result tsp_small(const vertex_type &, const tsp_budget &, Stats &);
 
         /*****************************************************************
          * @brief: Get the weight of the minimum edge adj to v
@@ -204,8 +313,143 @@ namespace ds {
          * @return: 
          *          the weight of the minimum edge adj to the input vertex
          *****************************************************************/
-        weight_type min_adjacent_edge(const vertex_type &);
+        weight_type min_adjacent_edge(const vertex_type &) const;
+
+        /*****************************************************************
+         * @brief: Get the weight of the second minimum edge adj to v,
+         *         max() if v has less than two edges
+         *****************************************************************/
+        weight_type second_min_adjacent_edge(const vertex_type &) const;
+
+        /*****************************************************************
+         * @brief: minimum spanning tree by Prim's algorithm on the dense
+         *         matrix, O(n^2) with plain arrays instead of a heap.
+         *         Missing edges are never used
+         * @params: vertex_type root
+         *          the root of the tree
+         * @return:
+         *      mst_return_type:
+         *          the weight of the tree, max() if the graph is not
+         *          connected
+         *          the parent of every vertex, -1 for the root
+         *****************************************************************/
+        mst_return_type mst(const vertex_type &root = 0);
+
+        /*****************************************************************
+         * @brief: 1-tree of a special vertex, the minimum spanning tree
+         *         of the other vertices plus the two cheapest edges of
+         *         the special vertex. Every tour is a 1-tree, so its
+         *         weight is a lower bound of the tour cost
+         * @params: vertex_type special
+         *          the vertex left out of the spanning tree
+         * @return:
+         *      one_tree_return_type:
+         *          the weight of the 1-tree, max() if there is none
+         *          its n edges, the two of the special vertex last
+         *****************************************************************/
+        one_tree_return_type one_tree(const vertex_type &special = 0);
+
+        /* Side of the square blocks the metric closure works on */
+        static constexpr size_type CLOSURE_BLOCK = 64;
+
+        /*****************************************************************
+         * @brief: metric closure by Floyd-Warshall, every weight becomes
+         *         the cost of the shortest path between its vertices, so
+         *         missing edges of a connected graph get a weight. The
+         *         matrix is split into CLOSURE_BLOCK square blocks that
+         *         fit in cache, each round of blocks runs on the threads
+         * @params: size_type threads
+         *          worker threads, 0 means one per hardware thread
+         * @return:
+         *      next_hop_matrix - first vertex of a shortest path from
+         *          i to j, -1 if there is no path
+         *****************************************************************/
+        next_hop_matrix metric_closure(size_type threads = 1);
+
+        /*****************************************************************
+         * @brief: expand a path over the metric closure to the edges of
+         *         the graph it was computed on
+         * @params:
+         *      ds::array_list<vertex_type> - the path, e.g. a tour
+         *      next_hop_matrix - as returned by metric_closure
+         * @return:
+         *      ds::array_list<vertex_type> - the path through the
+         *          intermediate vertices, empty if a step has no path
+         *****************************************************************/
+        static ds::array_list<vertex_type> expand_path(const ds::array_list<vertex_type> &, const next_hop_matrix &);
+
+        /*****************************************************************
+         * @brief: the edges of the graph as a sparse adjacency, built
+         *         once and shared by the shortest paths procedures
+         * @return:
+         *      adjacency_type - every edge in both directions
+         *****************************************************************/
+        adjacency_type adjacency() const;
+
+        /*****************************************************************
+         * @brief: shortest paths by Dijkstra's algorithm over the sparse
+         *         adjacency, with an indexed heap and decrease-key.
+         *         Weights must not be negative
+         * @params:
+         *      ds::array_list<vertex_type> - sources, every vertex gets
+         *          its distance to the nearest one
+         *      adjacency_type - as returned by adjacency()
+         * @return:
+         *      shortest_paths_return_type:
+         *          the distance of every vertex, max() if unreachable
+         *          the parent of every vertex, -1 for the sources and
+         *          the unreachable vertices
+         *****************************************************************/
+        shortest_paths_return_type shortest_paths(const vertex_type &source);
+        shortest_paths_return_type shortest_paths(const ds::array_list<vertex_type> &, const adjacency_type &) const;
+
+        /*****************************************************************
+         * @brief: shortest paths as above with a radix heap, faster for
+         *         integer weights, distances must fit in 32 bits
+         *****************************************************************/
+        shortest_paths_return_type shortest_paths_radix(const ds::array_list<vertex_type> &, const adjacency_type &) const;
+
+        /*****************************************************************
+         * @brief: cost of many paths at once, costs[i] is the sum of the
+         *         edges between consecutive vertices of tours[i]. The
+         *         matrix is flattened once for the batch, with AVX2 the
+         *         weights of 8 edges are fetched by one gather
+         * @params:
+         *      ds::array_list<ds::array_list<vertex_type>> - the paths,
+         *          closed tours repeat their first vertex at the end
+         *      size_type - worker threads, 0 means one per hardware
+         *          thread
+         * @return:
+         *      ds::array_list<weight_type> - the cost of every path
+         *****************************************************************/
+        ds::array_list<weight_type> path_costs(const ds::array_list<ds::array_list<vertex_type>> &, size_type threads = 1) const;
     private:
+        /*************************************************************
+         * @brief: helper for path_costs, cost of one path from the
+         *         row major flat matrix w of n vertices
+         *************************************************************/
+        static weight_type flat_path_cost(const weight_type *, size_type, const vertex_type *, size_type);
+
+        /*************************************************************
+         * @brief: helper for mst, Prim's algorithm from a root that
+         *         leaves one vertex out of the tree, -1 for none
+         *************************************************************/
+        mst_return_type prim(const vertex_type &, const vertex_type &);
+
+        /*************************************************************
+         * @brief: helper for prim, index of the first minimum of n
+         *         keys, with AVX2 the minimum is taken 8 keys at a time
+         *************************************************************/
+        static size_type min_key_index(const weight_type *, size_type);
+
+        /*************************************************************
+         * @brief: helper for metric_closure, relax the block of rows
+         *         [i0, i1) and columns [j0, j1) through the vertices
+         *         [k0, k1) of the row major distances d and next hops
+         *************************************************************/
+        static void closure_block(weight_type *, vertex_type *, size_type, size_type, size_type,
+                                  size_type, size_type, size_type, size_type);
+
         /*************************************************************************
          * @brief: helper for tsp, get all visitable vertices from current vertex
          * @params: 
@@ -215,6 +459,41 @@ namespace ds {
          *************************************************************************/
         ds::array_list<vertex_type> visitable_vertices(ds::array_list<vertex_type> &);
 
+        /*************************************************************
+         * @brief: helper for tsp, start from budget.initial_tour when
+         *         it is a closed tour from init_vertex through every
+         *         vertex once, otherwise leave the result untouched
+         *************************************************************/
+        void warm_start(const vertex_type &, const tsp_budget &, tsp_result &);
+
+        /*************************************************************
+         * @brief: helper for tsp, cheapest way from a vertex through
+         *         every vertex of a set and back to the start, by the
+         *         Held-Karp dynamic program over subsets of the set
+         * @params:
+         *      vertex_type - vertex the path ends at
+         *      ds::array_list<vertex_type> - the unvisited vertices
+         *      vertex_type - start vertex the tour returns to
+         *      vertex_type - the last unvisited vertex must be above
+         *          it, -1 for no constraint
+         *      ds::array_list<vertex_type> - filled with the unvisited
+         *          vertices in order followed by the start vertex
+         * @return:
+         *      weight_type - cost of the completion, max() if no
+         *          completion satisfies the constraint
+         *************************************************************/
+        weight_type held_karp_completion(const vertex_type &, const ds::array_list<vertex_type> &,
+                                         const vertex_type &, const vertex_type &, ds::array_list<vertex_type> &);
+
+        /*************************************************************
+         * @brief: helper for tsp, for every vertex the other vertices
+         *         by increasing weight of the edge between them
+         * @return:
+         *      ds::array_list<ds::array_list<vertex_type>> - row v
+         *          holds the neighbours of v, nearest first
+         *************************************************************/
+        ds::array_list<ds::array_list<vertex_type>> nearest_neighbors();
+
         /*************************************************************
          * @brief: helper for tsp, calculate the current path cost
          * @params:
@@ -222,8 +501,45 @@ namespace ds {
          * @return:
          *      weight_type - denotes the total cost for the path
          **************************************************************/
-        weight_type path_cost(ds::array_list<vertex_type> &); 
-        
+        weight_type path_cost(ds::array_list<vertex_type> &);
+
+        /* Search state of branch and bound, extended and undone in place */
+        struct bnb_state {
+            /* the current path, from the start vertex */
+            ds::array_list<vertex_type> path;
+            ds::array_list<bool> visited;
+            /* visited as a bit mask, only kept when the memo is enabled */
+            tsp_transposition_table::mask_type visited_mask;
+            /* cost of the current path */
+            weight_type cost;
+            size_type nodes;
+            tsp_transposition_table memo;
+            ds::array_list<ds::array_list<vertex_type>> nearest;
+        };
+
+        /*************************************************************
+         * @brief: helper for tsp_bnb_v2, process the node at the end
+         *         of state.path and search below it depth first
+         * @params:
+         *      bnb_state - the search state, left as it was found
+         *      Bound - the bound policy, following state.path
+         *      weight_type - lower bound of the node
+         *      tsp_budget, tsp_result, Stats - as in tsp_bnb_v2
+         * @return:
+         *      bool - false when the budget stopped the search, the
+         *          result lower bound then covers this subtree
+         *************************************************************/
+        template <class Bound, class Stats>
+        bool tsp_bnb_search(bnb_state &, Bound &, weight_type, const tsp_budget &, tsp_result &, Stats &);
+
+        /*************************************************************
+         * @brief: helper for tsp_small, Held-Karp dp for a graph of
+         *         exactly N vertices. Weights, subsets and tables all
+         *         have sizes known at compile time
+         *************************************************************/
+        template <size_type N, class Stats>
+        tsp_result tsp_small_fixed(const vertex_type &, const tsp_budget &, Stats &);
+
         /* list of vertices */
         ds::array_list<vertex_type> vertices;
         
@@ -232,21 +548,108 @@ namespace ds {
 
         /* Define unreachable value for edge(a, b) = null */
         const int UNREACHABLE_VALUE = 0;
+
+        /* Cached statistics, kept up to date by set_edge_weight */
+        size_type edges;
+        ds::array_list<size_type> degrees;
+        /* two cheapest edges of every vertex, max() where missing */
+        ds::array_list<weight_type> min_adjacent;
+        ds::array_list<weight_type> second_min_adjacent;
+        weight_type min_edge;
+
+        /* Compute all cached statistics from the cost matrix */
+        void rebuild_statistics();
+
+        /* Compute the two cheapest edges of a vertex from its row */
+        void rescan_adjacent(const vertex_type &);
     
     };
 
 
-    undirected_graph::weight_type undirected_graph::min_adjacent_edge(const undirected_graph::vertex_type &v) {
-        weight_type min_weight = std::numeric_limits<weight_type>::max();
-        for (vertex_type i = 0; i < vertices_size(); ++i) {
-            if (cost_matrix[v][i] < min_weight && cost_matrix[v][i] != UNREACHABLE_VALUE) {
-                min_weight = cost_matrix[v][i];
+    inline undirected_graph::weight_type undirected_graph::min_adjacent_edge(const undirected_graph::vertex_type &v) const {
+        return min_adjacent[v];
+    }
+
+    inline undirected_graph::weight_type undirected_graph::second_min_adjacent_edge(const undirected_graph::vertex_type &v) const {
+        return second_min_adjacent[v];
+    }
+
+    inline void undirected_graph::set_edge_weight(undirected_graph::edge_type e, undirected_graph::weight_type weight) {
+        const weight_type old = cost_matrix[e.first][e.second];
+        cost_matrix[e.first][e.second] = weight;
+        cost_matrix[e.second][e.first] = weight;
+        if (e.first == e.second || old == weight) {
+            return;
+        }
+
+        const bool existed = old != UNREACHABLE_VALUE;
+        const bool exists = weight != UNREACHABLE_VALUE;
+        edges = edges + exists - existed;
+
+        for (vertex_type v : {e.first, e.second}) {
+            degrees[v] = degrees[v] + exists - existed;
+            if (existed && old <= second_min_adjacent[v]) {
+                /* one of the two cheapest edges changed */
+                rescan_adjacent(v);
+            } else if (exists && weight < min_adjacent[v]) {
+                second_min_adjacent[v] = min_adjacent[v];
+                min_adjacent[v] = weight;
+            } else if (exists && weight < second_min_adjacent[v]) {
+                second_min_adjacent[v] = weight;
             }
         }
-        return min_weight;
+
+        if (exists && weight < min_edge) {
+            min_edge = weight;
+        } else if (existed && old == min_edge) {
+            min_edge = std::numeric_limits<weight_type>::max();
+            for (size_type v = 0; v < vertices_size(); ++v) {
+                min_edge = std::min(min_edge, min_adjacent[v]);
+            }
+        }
+    }
+
+    inline void undirected_graph::rebuild_statistics() {
+        const size_type n = vertices_size();
+        edges = 0;
+        degrees = ds::array_list<size_type>(n, 0);
+        min_adjacent = ds::array_list<weight_type>(n, std::numeric_limits<weight_type>::max());
+        second_min_adjacent = ds::array_list<weight_type>(n, std::numeric_limits<weight_type>::max());
+        min_edge = std::numeric_limits<weight_type>::max();
+
+        for (vertex_type v = 0; v < static_cast<vertex_type>(n); ++v) {
+            rescan_adjacent(v);
+            edges += degrees[v];
+            min_edge = std::min(min_edge, min_adjacent[v]);
+        }
+        edges /= 2;
     }
 
-    undirected_graph::weight_type undirected_graph::path_cost(ds::array_list<undirected_graph::vertex_type> &tour) {
+    inline void undirected_graph::rescan_adjacent(const undirected_graph::vertex_type &v) {
+        weight_type first = std::numeric_limits<weight_type>::max();
+        weight_type second = first;
+        size_type degree = 0;
+
+        for (size_type i = 0; i < vertices_size(); ++i) {
+            weight_type w = cost_matrix[v][i];
+            if (i == static_cast<size_type>(v) || w == UNREACHABLE_VALUE) {
+                continue;
+            }
+            ++degree;
+            if (w < first) {
+                second = first;
+                first = w;
+            } else if (w < second) {
+                second = w;
+            }
+        }
+
+        degrees[v] = degree;
+        min_adjacent[v] = first;
+        second_min_adjacent[v] = second;
+    }
+
+    inline undirected_graph::weight_type undirected_graph::path_cost(ds::array_list<undirected_graph::vertex_type> &tour) {
         weight_type total_cost = 0;
         for (int i = 0, j = 1; j < tour.size(); ++i, ++j) {
             vertex_type from = tour[i];
@@ -256,7 +659,581 @@ namespace ds {
         return total_cost;
     }
 
-    ds::array_list<undirected_graph::vertex_type> undirected_graph::visitable_vertices(ds::array_list<undirected_graph::vertex_type> &current_vertices) {
+    inline undirected_graph::weight_type undirected_graph::flat_path_cost(const undirected_graph::weight_type *w, undirected_graph::size_type n,
+            const undirected_graph::vertex_type *tour, undirected_graph::size_type length) {
+        weight_type total = 0;
+        size_type i = 0;
+
+#if defined(__AVX2__)
+        /* 8 edges per step: indices tour[i] * n + tour[i + 1] in 64 bit lanes, as
+         * n * n overflows 32 bits past 46340 vertices, two gathers of 4 */
+        const __m256i stride = _mm256_set1_epi64x(static_cast<long long>(n));
+        __m256i sum = _mm256_setzero_si256();
+        for (; i + 8 < length; i += 8) {
+            __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tour + i));
+            __m256i to = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tour + i + 1));
+            __m256i low = _mm256_add_epi64(_mm256_mul_epu32(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(from)), stride),
+                                           _mm256_cvtepi32_epi64(_mm256_castsi256_si128(to)));
+            __m256i high = _mm256_add_epi64(_mm256_mul_epu32(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(from, 1)), stride),
+                                            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(to, 1)));
+            __m256i weights = _mm256_set_m128i(_mm256_i64gather_epi32(w, high, sizeof(weight_type)),
+                                               _mm256_i64gather_epi32(w, low, sizeof(weight_type)));
+            sum = _mm256_add_epi32(sum, weights);
+        }
+        alignas(32) weight_type lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), sum);
+        for (const auto &lane : lanes) {
+            total += lane;
+        }
+#endif
+
+        for (; i + 1 < length; ++i) {
+            total += w[tour[i] * n + tour[i + 1]];
+        }
+        return total;
+    }
+
+    inline undirected_graph::mst_return_type undirected_graph::mst(const undirected_graph::vertex_type &root) {
+        return prim(root, -1);
+    }
+
+    inline undirected_graph::one_tree_return_type undirected_graph::one_tree(const undirected_graph::vertex_type &special) {
+        const weight_type none = std::numeric_limits<weight_type>::max();
+        const size_type n = vertices_size();
+        one_tree_return_type ret(none, ds::array_list<edge_type>());
+        if (n < 3) {
+            return ret;
+        }
+
+        auto tree = prim(special == 0 ? 1 : 0, special);
+        if (tree.first == none) {
+            return ret;
+        }
+
+        /* the two cheapest edges of the special vertex */
+        vertex_type first = -1;
+        vertex_type second = -1;
+        for (vertex_type v = 0; v < static_cast<vertex_type>(n); ++v) {
+            weight_type w = cost_matrix[special][v];
+            if (v == special || w == UNREACHABLE_VALUE) {
+                continue;
+            }
+            if (first < 0 || w < cost_matrix[special][first]) {
+                second = first;
+                first = v;
+            } else if (second < 0 || w < cost_matrix[special][second]) {
+                second = v;
+            }
+        }
+        if (second < 0) {
+            return ret;
+        }
+
+        ret.second = ds::array_list<edge_type>(n);
+        for (vertex_type v = 0; v < static_cast<vertex_type>(n); ++v) {
+            if (tree.second[v] >= 0) {
+                ret.second.push_back({tree.second[v], v});
+            }
+        }
+        ret.second.push_back({special, first});
+        ret.second.push_back({special, second});
+        ret.first = tree.first + cost_matrix[special][first] + cost_matrix[special][second];
+
+        return ret;
+    }
+
+    inline undirected_graph::mst_return_type undirected_graph::prim(const undirected_graph::vertex_type &root,
+                                                                     const undirected_graph::vertex_type &skip) {
+        const weight_type none = std::numeric_limits<weight_type>::max();
+        const size_type n = vertices_size();
+        mst_return_type ret(0, ds::array_list<vertex_type>(n, -1));
+        if (n == 0) {
+            return ret;
+        }
+
+        /* key of a vertex outside the tree is its cheapest edge into it, none inside */
+        ds::array_list<weight_type> key(n, none);
+        /* 0 outside the tree, -1 (all bits set) inside, used as a mask */
+        ds::array_list<weight_type> done(n, 0);
+        auto &parent = ret.second;
+
+        size_type remaining = n;
+        if (skip >= 0) {
+            done[skip] = -1;
+            --remaining;
+        }
+
+        vertex_type u = root;
+        key[u] = 0;
+        while (true) {
+            ret.first += key[u];
+            key[u] = none;
+            done[u] = -1;
+            if (--remaining == 0) {
+                break;
+            }
+
+            const weight_type *row = cost_matrix[u].cbegin();
+            weight_type *k = key.begin();
+            vertex_type *p = parent.begin();
+            const weight_type *d = done.cbegin();
+            size_type j = 0;
+#if defined(__AVX2__)
+            /* 8 keys per step, a missing edge counts as none */
+            const __m256i unreachable = _mm256_set1_epi32(UNREACHABLE_VALUE);
+            const __m256i infinite = _mm256_set1_epi32(none);
+            const __m256i from = _mm256_set1_epi32(u);
+            for (; j + 8 <= n; j += 8) {
+                __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + j));
+                w = _mm256_blendv_epi8(w, infinite, _mm256_cmpeq_epi32(w, unreachable));
+                __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(k + j));
+                __m256i better = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(d + j)),
+                                                     _mm256_cmpgt_epi32(current, w));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(k + j), _mm256_blendv_epi8(current, w, better));
+                __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + j));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(p + j), _mm256_blendv_epi8(previous, from, better));
+            }
+#endif
+            for (; j < n; ++j) {
+                weight_type w = row[j] == UNREACHABLE_VALUE ? none : row[j];
+                if (!d[j] && w < k[j]) {
+                    k[j] = w;
+                    p[j] = u;
+                }
+            }
+
+            size_type next = min_key_index(key.cbegin(), n);
+            if (key[next] == none) {
+                ret.first = none;
+                return ret;
+            }
+            u = static_cast<vertex_type>(next);
+        }
+
+        return ret;
+    }
+
+    inline undirected_graph::size_type undirected_graph::min_key_index(const undirected_graph::weight_type *key, undirected_graph::size_type n) {
+        weight_type least = std::numeric_limits<weight_type>::max();
+        size_type j = 0;
+
+#if defined(__AVX2__)
+        __m256i lowest = _mm256_set1_epi32(least);
+        for (; j + 8 <= n; j += 8) {
+            lowest = _mm256_min_epi32(lowest, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + j)));
+        }
+        alignas(32) weight_type lanes[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), lowest);
+        for (const auto &lane : lanes) {
+            least = std::min(least, lane);
+        }
+#endif
+        for (; j < n; ++j) {
+            least = std::min(least, key[j]);
+        }
+
+        j = 0;
+#if defined(__AVX2__)
+        const __m256i target = _mm256_set1_epi32(least);
+        for (; j + 8 <= n; j += 8) {
+            __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(key + j)), target);
+            int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+            if (mask != 0) {
+                return j + __builtin_ctz(mask);
+            }
+        }
+#endif
+        for (; j < n; ++j) {
+            if (key[j] == least) {
+                return j;
+            }
+        }
+        return 0;
+    }
+
+    inline undirected_graph::next_hop_matrix undirected_graph::metric_closure(undirected_graph::size_type threads) {
+        const size_type n = vertices_size();
+        /* half of max() so that the sum of two distances never overflows */
+        const weight_type none = std::numeric_limits<weight_type>::max() / 2;
+
+        ds::array_list<weight_type> d(n * n, none);
+        ds::array_list<vertex_type> next(n * n, -1);
+        for (size_type i = 0; i < n; ++i) {
+            for (size_type j = 0; j < n; ++j) {
+                if (i == j) {
+                    d[i * n + j] = 0;
+                    next[i * n + j] = static_cast<vertex_type>(j);
+                } else if (cost_matrix[i][j] != UNREACHABLE_VALUE) {
+                    d[i * n + j] = cost_matrix[i][j];
+                    next[i * n + j] = static_cast<vertex_type>(j);
+                }
+            }
+        }
+
+        if (threads == 0) {
+            threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        }
+        ds::thread_pool pool(threads);
+
+        /************************************************************
+         * Blocked Floyd-Warshall: for every diagonal block k, first
+         * the block itself, then the blocks of its row and column,
+         * which only depend on it, then all the others, which only
+         * depend on those
+         ************************************************************/
+        const size_type B = CLOSURE_BLOCK;
+        const size_type blocks = (n + B - 1) / B;
+        weight_type *dist = d.begin();
+        vertex_type *hop = next.begin();
+        auto end = [n, B](size_type b) { return std::min((b + 1) * B, n); };
+
+        for (size_type k = 0; k < blocks; ++k) {
+            const size_type k0 = k * B;
+            const size_type k1 = end(k);
+            closure_block(dist, hop, n, k0, k1, k0, k1, k0, k1);
+
+            for (size_type b = 0; b < blocks; ++b) {
+                if (b == k) {
+                    continue;
+                }
+                pool.submit([=]() {
+                    closure_block(dist, hop, n, k0, k1, b * B, end(b), k0, k1);
+                    closure_block(dist, hop, n, b * B, end(b), k0, k1, k0, k1);
+                });
+            }
+            pool.wait_idle();
+
+            /* one row of blocks per task */
+            for (size_type i = 0; i < blocks; ++i) {
+                if (i == k) {
+                    continue;
+                }
+                pool.submit([=]() {
+                    for (size_type j = 0; j < blocks; ++j) {
+                        if (j != k) {
+                            closure_block(dist, hop, n, i * B, end(i), j * B, end(j), k0, k1);
+                        }
+                    }
+                });
+            }
+            pool.wait_idle();
+        }
+
+        next_hop_matrix ret(n, ds::array_list<vertex_type>());
+        for (size_type i = 0; i < n; ++i) {
+            ret[i] = ds::array_list<vertex_type>(n, -1);
+            for (size_type j = 0; j < n; ++j) {
+                weight_type w = d[i * n + j];
+                cost_matrix[i][j] = i == j || w == none ? UNREACHABLE_VALUE : w;
+                ret[i][j] = next[i * n + j];
+            }
+        }
+        rebuild_statistics();
+
+        return ret;
+    }
+
+    inline void undirected_graph::closure_block(undirected_graph::weight_type *d, undirected_graph::vertex_type *next,
+            undirected_graph::size_type n, undirected_graph::size_type i0, undirected_graph::size_type i1,
+            undirected_graph::size_type j0, undirected_graph::size_type j1, undirected_graph::size_type k0, undirected_graph::size_type k1) {
+        /* no path, as in metric_closure */
+        const weight_type none = std::numeric_limits<weight_type>::max() / 2;
+
+        for (size_type k = k0; k < k1; ++k) {
+            const weight_type *dk = d + k * n;
+            for (size_type i = i0; i < i1; ++i) {
+                weight_type *di = d + i * n;
+                vertex_type *ni = next + i * n;
+                const weight_type dik = di[k];
+                const vertex_type nik = ni[k];
+                if (dik >= none) {
+                    continue;
+                }
+
+                size_type j = j0;
+#if defined(__AVX2__)
+                /* 8 columns per step, the next hop follows the shorter distance */
+                const __m256i from = _mm256_set1_epi32(dik);
+                const __m256i hop = _mm256_set1_epi32(nik);
+                for (; j + 8 <= j1; j += 8) {
+                    __m256i through = _mm256_add_epi32(from, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dk + j)));
+                    __m256i current = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(di + j));
+                    __m256i shorter = _mm256_cmpgt_epi32(current, through);
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(di + j), _mm256_min_epi32(current, through));
+                    __m256i hops = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ni + j));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ni + j), _mm256_blendv_epi8(hops, hop, shorter));
+                }
+#endif
+                for (; j < j1; ++j) {
+                    weight_type through = dik + dk[j];
+                    if (through < di[j]) {
+                        di[j] = through;
+                        ni[j] = nik;
+                    }
+                }
+            }
+        }
+    }
+
+    inline ds::array_list<undirected_graph::vertex_type> undirected_graph::expand_path(
+            const ds::array_list<undirected_graph::vertex_type> &path, const undirected_graph::next_hop_matrix &next) {
+        ds::array_list<vertex_type> ret;
+        if (path.empty()) {
+            return ret;
+        }
+
+        ret.push_back(path[0]);
+        for (size_type i = 0; i + 1 < path.size(); ++i) {
+            for (vertex_type u = path[i]; u != path[i + 1];) {
+                u = next[u][path[i + 1]];
+                if (u < 0) {
+                    return ds::array_list<vertex_type>();
+                }
+                ret.push_back(u);
+            }
+        }
+        return ret;
+    }
+
+    inline undirected_graph::adjacency_type undirected_graph::adjacency() const {
+        const size_type n = vertices_size();
+        adjacency_type adj;
+        adj.offsets = ds::array_list<size_type>(n + 1);
+        adj.offsets.push_back(0);
+
+        for (size_type i = 0; i < n; ++i) {
+            for (size_type j = 0; j < n; ++j) {
+                if (i != j && cost_matrix[i][j] != UNREACHABLE_VALUE) {
+                    adj.targets.push_back(static_cast<vertex_type>(j));
+                    adj.weights.push_back(cost_matrix[i][j]);
+                }
+            }
+            adj.offsets.push_back(adj.targets.size());
+        }
+
+        return adj;
+    }
+
+    inline undirected_graph::shortest_paths_return_type undirected_graph::shortest_paths(const undirected_graph::vertex_type &source) {
+        return shortest_paths(ds::array_list<vertex_type>(1, source), adjacency());
+    }
+
+    inline undirected_graph::shortest_paths_return_type undirected_graph::shortest_paths(
+            const ds::array_list<undirected_graph::vertex_type> &sources, const undirected_graph::adjacency_type &adj) const {
+        const weight_type none = std::numeric_limits<weight_type>::max();
+        const size_type n = adj.offsets.size() - 1;
+        shortest_paths_return_type ret(ds::array_list<weight_type>(n, none), ds::array_list<vertex_type>(n, -1));
+        auto &distance = ret.first;
+        auto &parent = ret.second;
+
+        ds::indexed_priority_queue<weight_type, std::greater<weight_type>> queue(n);
+        for (size_type i = 0; i < sources.size(); ++i) {
+            if (distance[sources[i]] != 0) {
+                distance[sources[i]] = 0;
+                queue.push(sources[i], 0);
+            }
+        }
+
+        while (!queue.empty()) {
+            vertex_type u = static_cast<vertex_type>(queue.top());
+            queue.pop();
+            for (size_type e = adj.offsets[u]; e < adj.offsets[u + 1]; ++e) {
+                vertex_type v = adj.targets[e];
+                weight_type through = distance[u] + adj.weights[e];
+                if (through < distance[v]) {
+                    distance[v] = through;
+                    parent[v] = u;
+                    queue.push_or_update(v, through);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    inline undirected_graph::shortest_paths_return_type undirected_graph::shortest_paths_radix(
+            const ds::array_list<undirected_graph::vertex_type> &sources, const undirected_graph::adjacency_type &adj) const {
+        const weight_type none = std::numeric_limits<weight_type>::max();
+        const size_type n = adj.offsets.size() - 1;
+        shortest_paths_return_type ret(ds::array_list<weight_type>(n, none), ds::array_list<vertex_type>(n, -1));
+        auto &distance = ret.first;
+        auto &parent = ret.second;
+
+        ds::radix_heap<vertex_type> queue;
+        for (size_type i = 0; i < sources.size(); ++i) {
+            distance[sources[i]] = 0;
+            queue.push(0, sources[i]);
+        }
+
+        while (!queue.empty()) {
+            auto top = queue.top();
+            queue.pop();
+            vertex_type u = top.second;
+            /* a vertex is queued again whenever its distance drops, skip the stale entries */
+            if (static_cast<weight_type>(top.first) != distance[u]) {
+                continue;
+            }
+            for (size_type e = adj.offsets[u]; e < adj.offsets[u + 1]; ++e) {
+                vertex_type v = adj.targets[e];
+                weight_type through = distance[u] + adj.weights[e];
+                if (through < distance[v]) {
+                    distance[v] = through;
+                    parent[v] = u;
+                    queue.push(static_cast<std::uint32_t>(through), v);
+                }
+            }
+        }
+
+        return ret;
+    }
+
+    inline ds::array_list<undirected_graph::weight_type> undirected_graph::path_costs(
+            const ds::array_list<ds::array_list<undirected_graph::vertex_type>> &tours, undirected_graph::size_type threads) const {
+        const size_type n = vertices_size();
+        ds::array_list<weight_type> w(n * n, 0);
+        for (size_type i = 0; i < n; ++i) {
+            for (size_type j = 0; j < n; ++j) {
+                w[i * n + j] = cost_matrix[i][j];
+            }
+        }
+
+        ds::array_list<weight_type> costs(tours.size(), 0);
+        auto evaluate = [&](size_type first, size_type last) {
+            for (size_type t = first; t < last; ++t) {
+                costs[t] = flat_path_cost(w.cbegin(), n, tours[t].cbegin(), tours[t].size());
+            }
+        };
+
+        if (threads == 0) {
+            threads = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+        }
+        threads = std::min(threads, tours.size());
+        if (threads <= 1) {
+            evaluate(0, tours.size());
+            return costs;
+        }
+
+        /* one contiguous chunk of the batch per thread */
+        ds::thread_pool pool(threads);
+        size_type chunk = (tours.size() + threads - 1) / threads;
+        for (size_type first = 0; first < tours.size(); first += chunk) {
+            size_type last = std::min(first + chunk, tours.size());
+            pool.submit([&evaluate, first, last]() { evaluate(first, last); });
+        }
+        pool.wait_idle();
+
+        return costs;
+    }
+
+    inline void undirected_graph::warm_start(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, tsp_result &result) {
+        auto tour = budget.initial_tour;
+        if (tour.size() != vertices_size() + 1 || tour.front() != init_vertex || tour.back() != init_vertex) {
+            return;
+        }
+
+        ds::array_list<bool> seen(vertices_size(), false);
+        for (int i = 0; i + 1 < tour.size(); ++i) {
+            if (tour[i] < 0 || tour[i] >= vertices_size() || seen[tour[i]]) {
+                return;
+            }
+            seen[tour[i]] = true;
+        }
+
+        result.cost = path_cost(tour);
+        result.tour = tour;
+    }
+
+    inline undirected_graph::weight_type undirected_graph::held_karp_completion(const undirected_graph::vertex_type &from,
+            const ds::array_list<undirected_graph::vertex_type> &rest, const undirected_graph::vertex_type &init_vertex,
+            const undirected_graph::vertex_type &last_above, ds::array_list<undirected_graph::vertex_type> &completion) {
+        const size_type r = rest.size();
+        const size_type subsets = size_type(1) << r;
+        const weight_type unknown = std::numeric_limits<weight_type>::max();
+
+        /* cost[s * r + j]: cheapest path from `from` through the subset s ending at rest[j] */
+        ds::array_list<weight_type> cost(subsets * r, unknown);
+        ds::array_list<int> parent(subsets * r, -1);
+
+        for (size_type j = 0; j < r; ++j) {
+            cost[(size_type(1) << j) * r + j] = edge_weight({from, rest[j]});
+        }
+
+        for (size_type s = 1; s < subsets; ++s) {
+            for (size_type j = 0; j < r; ++j) {
+                weight_type current = cost[s * r + j];
+                if (!(s & (size_type(1) << j)) || current == unknown) {
+                    continue;
+                }
+                for (size_type k = 0; k < r; ++k) {
+                    if (s & (size_type(1) << k)) {
+                        continue;
+                    }
+                    size_type next = (s | (size_type(1) << k)) * r + k;
+                    weight_type candidate = current + edge_weight({rest[j], rest[k]});
+                    if (candidate < cost[next]) {
+                        cost[next] = candidate;
+                        parent[next] = static_cast<int>(j);
+                    }
+                }
+            }
+        }
+
+        size_type all = subsets - 1;
+        weight_type best = unknown;
+        int last = -1;
+        for (size_type j = 0; j < r; ++j) {
+            if (rest[j] <= last_above || cost[all * r + j] == unknown) {
+                continue;
+            }
+            weight_type candidate = cost[all * r + j] + edge_weight({rest[j], init_vertex});
+            if (candidate < best) {
+                best = candidate;
+                last = static_cast<int>(j);
+            }
+        }
+
+        ds::array_list<vertex_type> reversed;
+        for (int j = last; j != -1;) {
+            reversed.push_back(rest[j]);
+            int previous = parent[all * r + j];
+            all ^= size_type(1) << j;
+            j = previous;
+        }
+
+        completion.clear();
+        if (last == -1) {
+            return unknown;
+        }
+        for (int i = static_cast<int>(reversed.size()) - 1; i >= 0; --i) {
+            completion.push_back(reversed[i]);
+        }
+        completion.push_back(init_vertex);
+
+        return best;
+    }
+
+    inline ds::array_list<ds::array_list<undirected_graph::vertex_type>> undirected_graph::nearest_neighbors() {
+        ds::array_list<ds::array_list<vertex_type>> ret;
+
+        for (vertex_type v = 0; v < vertices_size(); ++v) {
+            ds::array_list<vertex_type> row;
+            for (vertex_type u = 0; u < vertices_size(); ++u) {
+                if (u != v) {
+                    row.push_back(u);
+                }
+            }
+
+            const auto &weights = cost_matrix[v];
+            algo::sort::quick_sort_recursive(row.begin(), row.end(), [&weights](const vertex_type &a, const vertex_type &b) {
+                return weights[a] < weights[b] || (weights[a] == weights[b] && a < b);
+            });
+            ret.push_back(row);
+        }
+
+        return ret;
+    }
+
+    inline ds::array_list<undirected_graph::vertex_type> undirected_graph::visitable_vertices(ds::array_list<undirected_graph::vertex_type> &current_vertices) {
         ds::array_list<vertex_type> ret;
 
         for (vertex_type i = 0; i < vertices_size(); ++i) {
@@ -268,18 +1245,47 @@ namespace ds {
         return ret;
     }
 
-    undirected_graph::tsp_return_type undirected_graph::tsp_brute_force(const undirected_graph::vertex_type &init_vertex) {
-        weight_type min_cost = std::numeric_limits<weight_type>::max();
-        ds::array_list<vertex_type> min_tour;
+    inline undirected_graph::tsp_return_type undirected_graph::tsp_brute_force(const undirected_graph::vertex_type &init_vertex) {
+        tsp_no_stats stats;
+        return tsp_brute_force(init_vertex, stats);
+    }
+
+    template <class Stats>
+    undirected_graph::tsp_return_type undirected_graph::tsp_brute_force(const undirected_graph::vertex_type &init_vertex, Stats &stats) {
+        auto result = tsp_brute_force(init_vertex, tsp_budget::unlimited(), stats);
+        return std::make_pair(result.cost, result.tour);
+    }
+
+    inline tsp_result undirected_graph::tsp_brute_force(const undirected_graph::vertex_type &init_vertex, tsp_budget budget) {
+        tsp_no_stats stats;
+        return tsp_brute_force(init_vertex, budget, stats);
+    }
+
+    template <class Stats>
+    tsp_result undirected_graph::tsp_brute_force(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        tsp_result result;
+        size_type nodes = 0;
+
+        stats.start();
+        warm_start(init_vertex, budget, result);
 
         /* Stack store the array of vertices that was explored in order */
         ds::array_list<ds::array_list<vertex_type>> stack;
         stack.push_back(ds::array_list<vertex_type>{init_vertex});
+        stats.on_push(stack.size(), sizeof(vertex_type));
 
         while (!stack.empty()) {
+            result.status = budget.check(nodes);
+            if (result.status != tsp_status::optimal) {
+                break;
+            }
+            ++nodes;
+
             auto current_vertices = stack.back();
 
             stack.pop_back();
+            stats.on_pop(sizeof(vertex_type) * current_vertices.size());
+            stats.on_expand(current_vertices.size());
 
             auto vvs = visitable_vertices(current_vertices);
 
@@ -288,6 +1294,8 @@ namespace ds {
                     auto next_current_vertices = current_vertices;
                     next_current_vertices.push_back(vv);
                     stack.push_back(next_current_vertices);
+                    stats.on_generate();
+                    stats.on_push(stack.size(), sizeof(vertex_type) * next_current_vertices.size());
                 }
             } else {
                 ds::array_list<vertex_type> current_tour = current_vertices;
@@ -295,19 +1303,29 @@ namespace ds {
 
                 weight_type tc = path_cost(current_tour);
 
-                if (tc < min_cost) {
-                    min_cost = tc;
-                    min_tour = current_tour;
+                if (tc < result.cost) {
+                    result.cost = tc;
+                    result.tour = current_tour;
+                    stats.on_incumbent(result.cost);
+                    budget.improved(result.cost, result.tour);
                 }
 
             }
 
         } 
 
-        return std::make_pair(min_cost, min_tour);
+        /* Every unexplored tour extends a path left on the stack */
+        result.lower_bound = result.cost;
+        for (auto &path : stack) {
+            result.lower_bound = std::min(result.lower_bound, tsp_bnb_lower_bound_v2(path));
+        }
+
+        stats.finish();
+
+        return result;
     }
 
-    undirected_graph::weight_type undirected_graph::tsp_bnb_lower_bound_v2(ds::array_list<undirected_graph::vertex_type> current_vertices) {
+    inline undirected_graph::weight_type undirected_graph::tsp_bnb_lower_bound_v2(ds::array_list<undirected_graph::vertex_type> current_vertices) {
         weight_type lower_bound = 0;
 
         for (int i = 0, j = 1; j < current_vertices.size(); ++i, ++j) {
@@ -330,59 +1348,377 @@ namespace ds {
         return lower_bound;
     }    
 
-    undirected_graph::tsp_return_type undirected_graph::tsp_bnb_v2(const undirected_graph::vertex_type &init_vertex) {
-        weight_type min_cost = std::numeric_limits<weight_type>::max();
-        ds::array_list<vertex_type> min_tour;
-        ds::array_list<vertex_type> current_vertices = {init_vertex};
+    inline undirected_graph::tsp_return_type undirected_graph::tsp_bnb_v2(const undirected_graph::vertex_type &init_vertex) {
+        tsp_no_stats stats;
+        return tsp_bnb_v2(init_vertex, stats);
+    }
 
-        weight_type current_lower_bound = tsp_bnb_lower_bound_v2(current_vertices);
-        // Stack store the current lower bound and the current path 
-        ds::array_list<std::pair<weight_type, ds::array_list<vertex_type>>> stack;
+    template <class Stats>
+    undirected_graph::tsp_return_type undirected_graph::tsp_bnb_v2(const undirected_graph::vertex_type &init_vertex, Stats &stats) {
+        auto result = tsp_bnb_v2(init_vertex, tsp_budget::unlimited(), stats);
+        return std::make_pair(result.cost, result.tour);
+    }
 
-        stack.push_back(std::make_pair(current_lower_bound, current_vertices));
+    inline tsp_result undirected_graph::tsp_bnb_v2(const undirected_graph::vertex_type &init_vertex, tsp_budget budget) {
+        tsp_no_stats stats;
+        return tsp_bnb_v2(init_vertex, budget, stats);
+    }
 
-        while (!stack.empty()) {
-            current_lower_bound = stack.back().first;
-            current_vertices = stack.back().second;
+    template <class Stats>
+    tsp_result undirected_graph::tsp_bnb_v2(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        return tsp_bnb<tsp_min_adjacent_bound>(init_vertex, budget, stats);
+    }
 
-            stack.pop_back();
+    template <class Bound>
+    tsp_result undirected_graph::tsp_bnb(const undirected_graph::vertex_type &init_vertex, tsp_budget budget) {
+        tsp_no_stats stats;
+        return tsp_bnb<Bound>(init_vertex, budget, stats);
+    }
+
+    template <class Bound, class Stats>
+    tsp_result undirected_graph::tsp_bnb(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        tsp_result result;
+
+        stats.start();
+        warm_start(init_vertex, budget, result);
+
+        /* One path, one visited set and one running cost for the whole search */
+        bnb_state state;
+        state.path = ds::array_list<vertex_type>(vertices_size() + 1);
+        state.path.push_back(init_vertex);
+        state.visited = ds::array_list<bool>(vertices_size(), false);
+        state.visited[init_vertex] = true;
+        state.visited_mask = 0;
+        state.cost = 0;
+        state.nodes = 0;
+
+        /* cheapest prefix per (visited set, current vertex) */
+        state.memo = tsp_transposition_table::for_graph(vertices_size());
+        if (state.memo.enabled()) {
+            state.visited_mask = tsp_transposition_table::mask_type(1) << init_vertex;
+        }
+
+        /* children are tried nearest first, the order is fixed once per solve */
+        state.nearest = nearest_neighbors();
+
+        stats.begin_bound();
+        Bound bound;
+        bound.initialize(cost_matrix, init_vertex);
+        weight_type root_bound = bound.bound();
+        stats.end_bound();
 
-            if (current_lower_bound >= min_cost) {
+        if (tsp_bnb_search(state, bound, root_bound, budget, result, stats)) {
+            result.lower_bound = result.cost;
+        }
+
+        stats.finish();
+
+        return result;
+    }
+
+    template <class Bound, class Stats>
+    bool undirected_graph::tsp_bnb_search(bnb_state &state, Bound &bound, weight_type lower_bound,
+                                          const tsp_budget &budget, tsp_result &result, Stats &stats) {
+        const weight_type infinite = std::numeric_limits<weight_type>::max();
+        const vertex_type init_vertex = state.path.front();
+        const vertex_type last = state.path.back();
+        weight_type &min_cost = result.cost;
+
+        result.status = budget.check(state.nodes);
+        if (result.status != tsp_status::optimal) {
+            /* Every unexplored tour is below this node or an open one above it */
+            result.lower_bound = std::min(min_cost, lower_bound);
+            return false;
+        }
+
+        if (lower_bound >= min_cost) {
+            stats.on_prune();
+            return true;
+        }
+
+        /* Another order of the same vertices reached this state at no higher cost */
+        vertex_type second = state.path.size() > 1 ? state.path[1] : init_vertex;
+        if (!state.memo.improve(state.visited_mask, last, state.cost, state.path.size(), second)) {
+            stats.on_prune();
+            return true;
+        }
+        ++state.nodes;
+        stats.on_expand(state.path.size());
+
+        size_type remaining = vertices_size() - state.path.size();
+
+        if (remaining == 0) {
+            weight_type tc = state.cost + cost_matrix[last][init_vertex];
+
+            if (tc < min_cost) {
+                min_cost = tc;
+                result.tour = state.path;
+                result.tour.push_back(init_vertex);
+                stats.on_incumbent(min_cost);
+                budget.improved(min_cost, result.tour);
+            }
+            return true;
+        }
+
+        if (remaining < budget.dp_threshold) {
+            /* Few vertices left, solve the whole subtree at once */
+            ds::array_list<vertex_type> vvs;
+            for (vertex_type v = 0; v < vertices_size(); ++v) {
+                if (!state.visited[v]) {
+                    vvs.push_back(v);
+                }
+            }
+
+            ds::array_list<vertex_type> completion;
+            vertex_type last_above = state.path.size() > 1 && vertices_size() > 2 ? state.path[1] : -1;
+            weight_type tail = held_karp_completion(last, vvs, init_vertex, last_above, completion);
+            weight_type tc = tail == infinite ? tail : state.cost + tail;
+
+            if (tc < min_cost) {
+                min_cost = tc;
+                result.tour = state.path;
+                for (const auto &v : completion) {
+                    result.tour.push_back(v);
+                }
+                stats.on_incumbent(min_cost);
+                budget.improved(min_cost, result.tour);
+            }
+
+            if (budget.past_deadline()) {
+                result.status = tsp_status::time_limit;
+                result.lower_bound = min_cost;
+                return false;
+            }
+            return true;
+        }
+
+        /* The node stays open while its children are searched, it only adds its path slot */
+        stats.on_push(state.path.size(), sizeof(vertex_type));
+
+        const auto &children = state.nearest[last];
+        bool finished = true;
+
+        for (size_type i = 0; i < children.size(); ++i) {
+            vertex_type vv = children[i];
+
+            /**********************************************************
+             * Children come nearest first and their child_bound does
+             * not decrease along them: once one of them can't beat the
+             * incumbent, none of the rest can
+             **********************************************************/
+            if (lower_bound >= min_cost || bound.child_bound(last, vv) >= min_cost) {
+                break;
+            }
+            if (state.visited[vv]) {
                 continue;
             }
+            stats.on_generate();
+
+            /* extend */
+            state.path.push_back(vv);
+            state.visited[vv] = true;
+            state.cost += cost_matrix[last][vv];
+            if (state.memo.enabled()) {
+                state.visited_mask |= tsp_transposition_table::mask_type(1) << vv;
+            }
 
-            auto vvs = visitable_vertices(current_vertices);
+            stats.begin_bound();
+            bound.extend(last, vv);
+            auto child_bound = bound.bound();
+            stats.end_bound();
 
-            if (!vvs.empty()) {
-                ds::array_list<std::pair<weight_type, ds::array_list<vertex_type>>> tmp;
-                for (const auto &vv : vvs) {
-                    auto next_current_vertices = current_vertices;
-                    next_current_vertices.push_back(vv);
-                    auto next_lower_bound = tsp_bnb_lower_bound_v2(next_current_vertices);
-                    tmp.push_back(std::make_pair(next_lower_bound, next_current_vertices));
+            /* No tour extends this path, e.g. only its reversed orientation is searched */
+            if (child_bound == infinite) {
+                stats.on_prune();
+            } else {
+                finished = tsp_bnb_search(state, bound, child_bound, budget, result, stats);
+            }
+
+            /* undo */
+            bound.retract(last, vv);
+            if (state.memo.enabled()) {
+                state.visited_mask &= ~(tsp_transposition_table::mask_type(1) << vv);
+            }
+            state.cost -= cost_matrix[last][vv];
+            state.visited[vv] = false;
+            state.path.pop_back();
+
+            if (!finished) {
+                result.lower_bound = std::min(result.lower_bound, lower_bound);
+                break;
+            }
+        }
+
+        stats.on_pop(sizeof(vertex_type));
+        return finished;
+    }
+
+    inline undirected_graph::tsp_return_type undirected_graph::tsp_small(const undirected_graph::vertex_type &init_vertex) {
+        tsp_no_stats stats;
+        return tsp_small(init_vertex, stats);
+    }
+
+    template <class Stats>
+    undirected_graph::tsp_return_type undirected_graph::tsp_small(const undirected_graph::vertex_type &init_vertex, Stats &stats) {
+        auto result = tsp_small(init_vertex, tsp_budget::unlimited(), stats);
+        return std::make_pair(result.cost, result.tour);
+    }
+
+    inline tsp_result undirected_graph::tsp_small(const undirected_graph::vertex_type &init_vertex, tsp_budget budget) {
+        tsp_no_stats stats;
+        return tsp_small(init_vertex, budget, stats);
+    }
+
+    template <class Stats>
+    tsp_result undirected_graph::tsp_small(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        switch (vertices_size()) {
+            case 2: return tsp_small_fixed<2>(init_vertex, budget, stats);
+            case 3: return tsp_small_fixed<3>(init_vertex, budget, stats);
+            case 4: return tsp_small_fixed<4>(init_vertex, budget, stats);
+            case 5: return tsp_small_fixed<5>(init_vertex, budget, stats);
+            case 6: return tsp_small_fixed<6>(init_vertex, budget, stats);
+            case 7: return tsp_small_fixed<7>(init_vertex, budget, stats);
+            case 8: return tsp_small_fixed<8>(init_vertex, budget, stats);
+            case 9: return tsp_small_fixed<9>(init_vertex, budget, stats);
+            case 10: return tsp_small_fixed<10>(init_vertex, budget, stats);
+            case 11: return tsp_small_fixed<11>(init_vertex, budget, stats);
+            case 12: return tsp_small_fixed<12>(init_vertex, budget, stats);
+            case 13: return tsp_small_fixed<13>(init_vertex, budget, stats);
+            case 14: return tsp_small_fixed<14>(init_vertex, budget, stats);
+            case 15: return tsp_small_fixed<15>(init_vertex, budget, stats);
+            case 16: return tsp_small_fixed<16>(init_vertex, budget, stats);
+        }
+        return tsp_bnb_v2(init_vertex, budget, stats);
+    }
+
+    template <undirected_graph::size_type N, class Stats>
+    tsp_result undirected_graph::tsp_small_fixed(const undirected_graph::vertex_type &init_vertex, const tsp_budget &budget, Stats &stats) {
+        static_assert(N >= 2 && N <= SMALL_TSP_MAX_VERTICES, "tsp_small_fixed needs 2..SMALL_TSP_MAX_VERTICES vertices");
+
+        /* the dp runs over the R vertices other than the start, the start is index R */
+        constexpr size_type R = N - 1;
+        constexpr std::uint32_t SUBSETS = std::uint32_t(1) << R;
+        const weight_type infinite = std::numeric_limits<weight_type>::max();
+
+        /* cost[s][j]: cheapest path from the start through the subset s ending at j,
+           only entries with j in s are ever written or read */
+        struct table {
+            std::array<std::array<weight_type, R>, SUBSETS> cost;
+            std::array<std::array<std::uint8_t, R>, SUBSETS> parent;
+        };
+
+        /* Up to 2.5 MB for N = 16, kept per thread and reused by every solve */
+        static thread_local std::unique_ptr<table> tables;
+        if (tables == nullptr) {
+            tables.reset(new table);
+        }
+        auto &cost = tables->cost;
+        auto &parent = tables->parent;
+
+        tsp_result result;
+        size_type nodes = 0;
+
+        stats.start();
+        warm_start(init_vertex, budget, result);
+
+        std::array<vertex_type, N> id;
+        for (vertex_type v = 0, i = 0; v < static_cast<vertex_type>(N); ++v) {
+            if (v != init_vertex) {
+                id[i++] = v;
+            }
+        }
+        id[R] = init_vertex;
+
+        std::array<std::array<weight_type, N>, N> w;
+        for (size_type i = 0; i < N; ++i) {
+            for (size_type j = 0; j < N; ++j) {
+                w[i][j] = cost_matrix[id[i]][id[j]];
+            }
+        }
+
+        /* Subsets in increasing order, every subset comes after its own subsets */
+        for (std::uint32_t s = 1; s < SUBSETS; ++s) {
+            result.status = budget.check(nodes);
+            if (result.status != tsp_status::optimal) {
+                break;
+            }
+            ++nodes;
+            if (Stats::enabled) {
+                size_type depth = 1;
+                for (std::uint32_t bits = s; bits != 0; bits &= bits - 1) {
+                    ++depth;
                 }
-                algo::sort::insertion_sort(tmp.begin(), tmp.end(), [](const auto &a, const auto &b) {
-                    return a.first > b.first;
-                });
-                for (const auto &t : tmp) {
-                    stack.push_back(t);
+                stats.on_expand(depth);
+            }
+
+            /* pull: the best path to k through s extends a path through s without k */
+            for (size_type k = 0; k < R; ++k) {
+                const std::uint32_t bit = std::uint32_t(1) << k;
+                if (!(s & bit)) {
+                    continue;
                 }
-            } else {
-                ds::array_list<vertex_type> current_tour = current_vertices;
-                current_tour.push_back(init_vertex);
 
-                weight_type tc = path_cost(current_tour);
+                const std::uint32_t previous = s ^ bit;
+                if (previous == 0) {
+                    cost[s][k] = w[R][k];
+                    parent[s][k] = static_cast<std::uint8_t>(R);
+                    continue;
+                }
 
-                if (tc < min_cost) {
-                    min_cost = tc;
-                    min_tour = current_tour;
+                const auto &row = cost[previous];
+                weight_type best = infinite;
+                size_type from = R;
+                /* branch free over the fixed R, entries outside previous are skipped by select */
+                for (size_type j = 0; j < R; ++j) {
+                    weight_type candidate = (previous >> j) & 1 ? row[j] + w[j][k] : infinite;
+                    from = candidate < best ? j : from;
+                    best = candidate < best ? candidate : best;
                 }
+                cost[s][k] = best;
+                parent[s][k] = static_cast<std::uint8_t>(from);
             }
         }
 
-        return std::make_pair(min_cost, min_tour);
-    }
+        if (result.status != tsp_status::optimal) {
+            /* a partial dp proves nothing about the tours it has not reached */
+            result.lower_bound = 0;
+            stats.finish();
+            return result;
+        }
+
+        const std::uint32_t all = SUBSETS - 1;
+        weight_type best = infinite;
+        size_type last = R;
+        for (size_type j = 0; j < R; ++j) {
+            if (cost[all][j] + w[j][R] < best) {
+                best = cost[all][j] + w[j][R];
+                last = j;
+            }
+        }
 
+        if (best < result.cost) {
+            std::array<vertex_type, N + 1> tour;
+            tour[0] = init_vertex;
+            tour[N] = init_vertex;
+            std::uint32_t s = all;
+            for (size_type i = R, j = last; i > 0; --i) {
+                tour[i] = id[j];
+                size_type previous = parent[s][j];
+                s &= ~(std::uint32_t(1) << j);
+                j = previous;
+            }
+
+            result.cost = best;
+            result.tour = ds::array_list<vertex_type>(tour.data(), tour.data() + tour.size());
+            stats.on_incumbent(result.cost);
+            budget.improved(result.cost, result.tour);
+        }
+        result.lower_bound = result.cost;
+
+        stats.finish();
+
+        return result;
+    }
 }
 
 
@@ -0,0 +1,112 @@
+#pragma once
+#ifndef INDEXED_PRIORITY_QUEUE_HPP
+#define INDEXED_PRIORITY_QUEUE_HPP
+
+#include "heap.hpp"
+#include "array_list.hpp"
+
+#include <cstddef>
+#include <functional>
+
+namespace ds {
+    /*****************************************************************
+     * Priority queue of the ids 0 .. capacity - 1, each with a key.
+     * The position of every id in the heap is tracked, so the key of
+     * a queued id can be changed in O(log n), e.g. the decrease-key of
+     * Dijkstra. As in priority_queue the top is the largest key for
+     * std::less, use std::greater for the smallest
+     *****************************************************************/
+    template <typename Key, class Compare = std::less<Key>>
+    class indexed_priority_queue {
+    public:
+        typedef Key key_type;
+        typedef std::size_t size_type;
+        typedef std::size_t id_type;
+        typedef Compare key_compare;
+
+        /* Empty queue for the ids below capacity */
+        explicit indexed_priority_queue(size_type capacity, const Compare &compare = Compare())
+            : comp_(compare), heap_(capacity), keys_(capacity, Key()), positions_(capacity, NOT_QUEUED) {}
+
+        /* Check if the id is in the queue */
+        bool contains(id_type id) const {
+            return positions_[id] != NOT_QUEUED;
+        }
+
+        /* Key of a queued id */
+        const key_type& key(id_type id) const {
+            return keys_[id];
+        }
+
+        /* Id with the first key */
+        id_type top() const {
+            return heap_.front();
+        }
+
+        /* Key of the top id */
+        const key_type& top_key() const {
+            return keys_[heap_.front()];
+        }
+
+        bool empty() const {
+            return heap_.empty();
+        }
+
+        size_type size() const {
+            return heap_.size();
+        }
+
+        /* Add an id that is not in the queue */
+        void push(id_type id, const key_type &key) {
+            keys_[id] = key;
+            heap_.push_back(id);
+            algo::heap::sift_up(heap_.begin(), heap_.size() - 1, before(), moved());
+        }
+
+        /* Change the key of a queued id, in either direction */
+        void update(id_type id, const key_type &key) {
+            bool up = comp_(keys_[id], key);
+            keys_[id] = key;
+            if (up) {
+                algo::heap::sift_up(heap_.begin(), positions_[id], before(), moved());
+            } else {
+                algo::heap::sift_down(heap_.begin(), heap_.end(), positions_[id], before(), moved());
+            }
+        }
+
+        /* Push the id, or update its key if it is queued */
+        void push_or_update(id_type id, const key_type &key) {
+            contains(id) ? update(id, key) : push(id, key);
+        }
+
+        /* Pop the top id out of the queue */
+        void pop() {
+            positions_[heap_.front()] = NOT_QUEUED;
+            heap_.front() = heap_.back();
+            heap_.pop_back();
+            if (!heap_.empty()) {
+                algo::heap::sift_down(heap_.begin(), heap_.end(), 0, before(), moved());
+            }
+        }
+
+    private:
+        static constexpr size_type NOT_QUEUED = static_cast<size_type>(-1);
+
+        /* Order of the ids in the heap, by their keys */
+        auto before() const {
+            return [this](id_type a, id_type b) { return comp_(keys_[a], keys_[b]); };
+        }
+
+        /* Keep the position of every id in the heap */
+        auto moved() {
+            return [this](id_type id, size_type position) { positions_[id] = position; };
+        }
+
+        key_compare comp_;
+        ds::array_list<id_type> heap_;
+        ds::array_list<key_type> keys_;
+        ds::array_list<size_type> positions_;
+    };
+}
+
+#endif
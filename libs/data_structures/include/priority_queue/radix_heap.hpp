@@ -0,0 +1,98 @@
+#pragma once
+#ifndef RADIX_HEAP_HPP
+#define RADIX_HEAP_HPP
+
+#include "array_list.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace ds {
+    /*****************************************************************
+     * Monotone min priority queue on unsigned 32 bit keys. A key may
+     * never be below the last popped key, which holds for Dijkstra
+     * with non negative weights. Bucket b holds the keys whose highest
+     * bit that differs from the last popped key is bit b - 1, a key is
+     * moved to a lower bucket at most 32 times before it is popped.
+     * There is no decrease-key: push again and skip the stale values
+     *****************************************************************/
+    template <typename T>
+    class radix_heap {
+    public:
+        typedef std::uint32_t key_type;
+        typedef T value_type;
+        typedef std::pair<key_type, value_type> entry_type;
+        typedef std::size_t size_type;
+
+        radix_heap() : last_(0), size_(0) {}
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        size_type size() const {
+            return size_;
+        }
+
+        /* Add a value, key must not be below the last popped key */
+        void push(key_type key, const value_type &value) {
+            buckets_[bucket(key)].push_back({key, value});
+            ++size_;
+        }
+
+        /* Smallest key and its value */
+        const entry_type& top() {
+            refill();
+            return buckets_[0].back();
+        }
+
+        /* Pop the smallest key */
+        void pop() {
+            refill();
+            buckets_[0].pop_back();
+            --size_;
+        }
+
+    private:
+        static constexpr size_type BUCKETS = std::numeric_limits<key_type>::digits + 1;
+
+        size_type bucket(key_type key) const {
+            return key == last_ ? 0 : std::numeric_limits<key_type>::digits - __builtin_clz(key ^ last_);
+        }
+
+        /* When bucket 0 is empty, the smallest key of the first non empty
+           bucket becomes the last key and the bucket is spread below */
+        void refill() {
+            if (!buckets_[0].empty()) {
+                return;
+            }
+
+            size_type b = 1;
+            while (buckets_[b].empty()) {
+                ++b;
+            }
+
+            key_type least = std::numeric_limits<key_type>::max();
+            for (size_type i = 0; i < buckets_[b].size(); ++i) {
+                if (buckets_[b][i].first < least) {
+                    least = buckets_[b][i].first;
+                }
+            }
+            last_ = least;
+
+            for (size_type i = 0; i < buckets_[b].size(); ++i) {
+                buckets_[bucket(buckets_[b][i].first)].push_back(buckets_[b][i]);
+            }
+            buckets_[b].clear();
+        }
+
+        key_type last_;
+        size_type size_;
+        std::array<ds::array_list<entry_type>, BUCKETS> buckets_;
+    };
+}
+
+#endif
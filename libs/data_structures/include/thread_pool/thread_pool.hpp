@@ -0,0 +1,133 @@
+/**************************************************************
+ * Fixed size thread pool with a FIFO task queue
+ * Tasks are submitted as callables and return a std::future
+ **************************************************************/
+#pragma once
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "array_list.hpp"
+#include "linked_list.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace ds {
+    class thread_pool {
+    public:
+        typedef std::size_t size_type;
+        typedef std::function<void()> task_type;
+
+        /*****************************************************************
+         * @brief: start the worker threads
+         * @param: threads - number of workers, 0 means one per hardware
+         *         thread
+         *****************************************************************/
+        explicit thread_pool(size_type threads = 0) : m_stopping(false), m_active(0) {
+            if (threads == 0) {
+                threads = std::thread::hardware_concurrency();
+            }
+            if (threads == 0) {
+                threads = 1;
+            }
+
+            for (size_type i = 0; i < threads; ++i) {
+                m_workers.push_back(new std::thread([this]() { work(); }));
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool& operator=(const thread_pool &) = delete;
+
+        /* Runs every queued task, then joins the workers */
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_task_ready.notify_all();
+
+            for (auto &worker : m_workers) {
+                worker->join();
+                delete worker;
+            }
+        }
+
+        size_type size() const noexcept {
+            return m_workers.size();
+        }
+
+        /*****************************************************************
+         * @brief: queue a callable
+         * @return: future of the callable's result, an exception thrown
+         *          by the callable is rethrown by future::get
+         *****************************************************************/
+        template <typename F>
+        std::future<typename std::invoke_result<F>::type> submit(F f) {
+            typedef typename std::invoke_result<F>::type result_type;
+
+            auto task = std::make_shared<std::packaged_task<result_type()>>(std::move(f));
+            auto future = task->get_future();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back([task]() { (*task)(); });
+            }
+            m_task_ready.notify_one();
+
+            return future;
+        }
+
+        /* Block until the queue is empty and no task is running */
+        void wait_idle() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this]() { return m_tasks.empty() && m_active == 0; });
+        }
+
+    private:
+        void work() {
+            for (;;) {
+                task_type task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_task_ready.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+
+                    task = m_tasks.front();
+                    m_tasks.pop_front();
+                    ++m_active;
+                }
+
+                task();
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    --m_active;
+                    if (m_tasks.empty() && m_active == 0) {
+                        m_idle.notify_all();
+                    }
+                }
+            }
+        }
+
+        /* pointers since array_list copies its elements when it grows */
+        ds::array_list<std::thread *> m_workers;
+        ds::linked_list<task_type> m_tasks;
+
+        std::mutex m_mutex;
+        std::condition_variable m_task_ready;
+        std::condition_variable m_idle;
+        bool m_stopping;
+        size_type m_active;
+    };
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "directed_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+
+const int NONE = std::numeric_limits<int>::max();
+
+/* Cheapest tour over every order of the vertices, 0 weights are missing edges */
+int brute_force_tour(const ds::directed_graph::matrix &m) {
+    int n = m.size();
+    ds::array_list<int> order;
+    for (int i = 1; i < n; ++i) {
+        order.push_back(i);
+    }
+    int best = NONE;
+    do {
+        long long cost = 0;
+        int at = 0;
+        for (int i = 0; i <= n - 1 && cost < NONE; ++i) {
+            int to = i < n - 1 ? order[i] : 0;
+            cost = m[at][to] == 0 ? NONE : cost + m[at][to];
+            at = to;
+        }
+        best = std::min<long long>(best, cost);
+    } while (std::next_permutation(order.begin(), order.end()));
+    return best;
+}
+
+/* Cheapest assignment over every permutation without fixed points */
+int brute_force_assignment(const ds::directed_graph::matrix &m) {
+    int n = m.size();
+    ds::array_list<int> successor;
+    for (int i = 0; i < n; ++i) {
+        successor.push_back(i);
+    }
+    int best = NONE;
+    do {
+        long long cost = 0;
+        for (int i = 0; i < n && cost < NONE; ++i) {
+            cost = i == successor[i] || m[i][successor[i]] == 0 ? NONE : cost + m[i][successor[i]];
+        }
+        best = std::min<long long>(best, cost);
+    } while (std::next_permutation(successor.begin(), successor.end()));
+    return best;
+}
+
+ds::directed_graph::matrix random_matrix(int n, std::mt19937 &rng, int missing) {
+    std::uniform_int_distribution<int> cost(1, 100);
+    std::uniform_int_distribution<int> percent(0, 99);
+    ds::directed_graph::matrix m(n, ds::array_list<int>(n, 0));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            if (i != j && percent(rng) >= missing) {
+                m[i][j] = cost(rng);
+            }
+        }
+    }
+    return m;
+}
+
+
+int main() {
+    std::mt19937 rng(11);
+
+    /* one way edges */
+    ds::directed_graph g(ds::directed_graph::matrix(3, ds::array_list<int>(3, 0)));
+    g.set_edge_weight({0, 1}, 4);
+    g.set_edge_weight({1, 0}, 9);
+    if (g.edge_weight({0, 1}) != 4 || g.edge_weight({1, 0}) != 9 || g.edges_size() != 2 || g.symmetric()) {
+        return 1;
+    }
+    g.remove_edge({1, 0});
+    if (g.edges_size() != 1) {
+        return 1;
+    }
+
+    for (int n = 2; n <= 8; ++n) {
+        for (int missing : {0, 40}) {
+            for (int round = 0; round < 8; ++round) {
+                auto m = random_matrix(n, rng, missing);
+                ds::directed_graph h(m);
+                int optimum = brute_force_tour(m);
+
+                /* the assignment bound is exact for the assignment and below every tour */
+                if (h.assignment_bound() != brute_force_assignment(m) || h.assignment_bound() > optimum) {
+                    return 1;
+                }
+
+                for (int start : {0, n - 1}) {
+                    ds::tsp_stats stats;
+                    auto result = h.tsp_bnb(start, ds::tsp_budget(), stats);
+                    if (!result.optimal() || result.cost != optimum ||
+                        stats.nodes_expanded + stats.nodes_pruned != stats.nodes_generated + 1) {
+                        return 1;
+                    }
+                    if (optimum == NONE) {
+                        if (result.has_tour()) {
+                            return 1;
+                        }
+                        continue;
+                    }
+                    if (!is_tour(result.tour, n, start) || h.path_cost(result.tour) != optimum) {
+                        return 1;
+                    }
+                    for (int i = 0; i < n; ++i) {
+                        if (m[result.tour[i]][result.tour[i + 1]] == 0) {
+                            return 1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /* a larger instance, the reversed tour of an asymmetric optimum is no optimum */
+    auto m = random_matrix(40, rng, 0);
+    ds::directed_graph big(m);
+    auto [cost, tour] = big.tsp_bnb(0);
+    if (!is_tour(tour, 40, 0) || big.path_cost(tour) != cost || cost < big.assignment_bound()) {
+        return 1;
+    }
+    ds::array_list<int> reversed;
+    for (int i = 40; i >= 0; --i) {
+        reversed.push_back(tour[i]);
+    }
+    if (big.path_cost(reversed) < cost) {
+        return 1;
+    }
+
+    /* a warm start is kept when nothing beats it, a stop still bounds the optimum */
+    ds::tsp_budget warm;
+    warm.initial_tour = tour;
+    auto again = big.tsp_bnb(0, warm);
+    if (again.cost != cost || !again.optimal()) {
+        return 1;
+    }
+    auto stopped = big.tsp_bnb(0, ds::tsp_budget::nodes(3));
+    if (stopped.status != ds::tsp_status::node_limit || stopped.lower_bound > cost) {
+        return 1;
+    }
+
+    /* one vertex */
+    ds::directed_graph single(ds::directed_graph::matrix(1, ds::array_list<int>(1, 0)));
+    auto alone = single.tsp_bnb(0);
+    if (alone.first != 0 || !is_tour(alone.second, 1, 0)) {
+        return 1;
+    }
+
+    return 0;
+}
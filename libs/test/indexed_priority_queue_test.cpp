@@ -0,0 +1,78 @@
+#include "indexed_priority_queue.hpp"
+#include "array_list.hpp"
+
+#include <functional>
+#include <random>
+
+
+int main() {
+    ds::indexed_priority_queue<int> a(8);
+    a.push(3, 10);
+    a.push(5, 40);
+    a.push(1, 20);
+
+    if (a.top() != 5 || a.top_key() != 40 || a.size() != 3 || !a.contains(1) || a.contains(0)) {
+        return 1;
+    }
+
+    /* keys move both ways */
+    a.update(3, 50);
+    if (a.top() != 3) {
+        return 1;
+    }
+    a.update(3, 0);
+    a.pop();
+    if (a.top() != 1 || a.contains(5) || a.key(3) != 0) {
+        return 1;
+    }
+
+    /* random pushes, updates and pops against a plain scan, smallest first */
+    const int n = 200;
+    std::mt19937 rng(7);
+    ds::indexed_priority_queue<int, std::greater<int>> b(n);
+    ds::array_list<int> keys(n, 0);
+    ds::array_list<bool> queued(n, false);
+    for (int step = 0; step < 5000; ++step) {
+        int id = rng() % n;
+        int key = rng() % 1000;
+        if (rng() % 3 == 0 && !b.empty()) {
+            int least = -1;
+            for (int i = 0; i < n; ++i) {
+                if (queued[i] && (least < 0 || keys[i] < keys[least])) {
+                    least = i;
+                }
+            }
+            if (b.top_key() != keys[least]) {
+                return 1;
+            }
+            queued[b.top()] = false;
+            b.pop();
+        } else {
+            b.push_or_update(id, key);
+            keys[id] = key;
+            queued[id] = true;
+        }
+    }
+
+    int count = 0;
+    for (int i = 0; i < n; ++i) {
+        count += queued[i] ? 1 : 0;
+        if (b.contains(i) != queued[i]) {
+            return 1;
+        }
+    }
+    if (b.size() != count) {
+        return 1;
+    }
+
+    int previous = -1;
+    while (!b.empty()) {
+        if (b.top_key() < previous) {
+            return 1;
+        }
+        previous = b.top_key();
+        b.pop();
+    }
+
+    return 0;
+}
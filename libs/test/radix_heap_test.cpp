@@ -0,0 +1,62 @@
+#include "radix_heap.hpp"
+#include "array_list.hpp"
+
+#include <cstdint>
+#include <random>
+
+
+int main() {
+    ds::radix_heap<int> a;
+    a.push(7, 1);
+    a.push(3, 2);
+    a.push(3, 3);
+    a.push(100, 4);
+
+    if (a.size() != 4 || a.top().first != 3) {
+        return 1;
+    }
+    a.pop();
+    a.pop();
+    if (a.top().first != 7 || a.top().second != 1) {
+        return 1;
+    }
+
+    /* keys never below the last popped one, as in Dijkstra */
+    a.push(7, 5);
+    a.push(50, 6);
+    a.pop();
+    a.pop();
+    if (a.top().first != 50 || a.size() != 2) {
+        return 1;
+    }
+
+    /* random monotone sequence, every pop is the minimum and the count adds up */
+    std::mt19937 rng(3);
+    ds::radix_heap<int> b;
+    std::uint32_t last = 0;
+    int pushed = 0;
+    int popped = 0;
+    for (int step = 0; step < 20000; ++step) {
+        if (rng() % 2 == 0 || b.empty()) {
+            b.push(last + rng() % (1u << (rng() % 16)), step);
+            ++pushed;
+        } else {
+            if (b.top().first < last) {
+                return 1;
+            }
+            last = b.top().first;
+            b.pop();
+            ++popped;
+        }
+    }
+    while (!b.empty()) {
+        if (b.top().first < last) {
+            return 1;
+        }
+        last = b.top().first;
+        b.pop();
+        ++popped;
+    }
+
+    return pushed == popped ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+
+
+int main() {
+    ds::thread_pool pool(4);
+
+    if (pool.size() != 4) {
+        return 1;
+    }
+
+    auto square = pool.submit([]() { return 7 * 7; });
+    if (square.get() != 49) {
+        return 1;
+    }
+
+    std::atomic<int> counter(0);
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&counter]() { ++counter; });
+    }
+    pool.wait_idle();
+
+    if (counter != 1000) {
+        return 1;
+    }
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("failed"); });
+    try {
+        failing.get();
+        return 1;
+    } catch (const std::runtime_error &) {
+    }
+
+    return 0;
+}
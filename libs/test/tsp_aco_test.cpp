@@ -0,0 +1,65 @@
+#include "tsp_aco.hpp"
+#include "tsp_solver.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <chrono>
+
+
+int main() {
+    /* 2-opt reports the exact change of the cycle cost */
+    auto big = euclidean(200, 3);
+    ds::tsp_neighbor_matrix m(big, 10);
+    ds::array_list<int> tour;
+    for (int i = 0; i < 200; ++i) {
+        tour.push_back(i);
+    }
+    int before = m.cycle_cost(tour);
+    int delta = ds::tsp_two_opt_neighbors(m, tour);
+    if (delta >= 0 || m.cycle_cost(tour) != before + delta) {
+        return 1;
+    }
+    ds::array_list<bool> seen(200, false);
+    for (int i = 0; i < 200; ++i) {
+        if (seen[tour[i]]) {
+            return 1;
+        }
+        seen[tour[i]] = true;
+    }
+
+    /* small instances are solved to optimality */
+    auto small = euclidean(10, 5);
+    auto exact = small.tsp_bnb_v2(0, ds::tsp_budget());
+    auto colony = ds::tsp_solve(small, 0, ds::tsp_algorithm::ant_colony);
+    if (colony.cost != exact.cost || !is_tour(colony.tour, 10, 0) || tour_cost(small, colony.tour) != colony.cost) {
+        return 1;
+    }
+
+    /* the result does not depend on the number of threads */
+    ds::tsp_aco_params params;
+    params.iterations = 20;
+    params.threads = 1;
+    auto one = ds::tsp_aco(big, 7, params);
+    params.threads = 4;
+    auto four = ds::tsp_aco(big, 7, params);
+    if (one.cost != four.cost || !is_tour(one.tour, 200, 7) || tour_cost(big, one.tour) != one.cost ||
+        one.status != ds::tsp_status::heuristic || one.lower_bound > one.cost) {
+        return 1;
+    }
+    for (int i = 0; i < one.tour.size(); ++i) {
+        if (one.tour[i] != four.tour[i]) {
+            return 1;
+        }
+    }
+
+    /* without an iteration limit the deadline stops the colony */
+    params.iterations = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto timed = ds::tsp_aco(big, 0, params, ds::tsp_budget::within(std::chrono::milliseconds(100)));
+    if (timed.status != ds::tsp_status::time_limit || !is_tour(timed.tour, 200, 0) ||
+        std::chrono::steady_clock::now() - start > std::chrono::seconds(5)) {
+        return 1;
+    }
+
+    return 0;
+}
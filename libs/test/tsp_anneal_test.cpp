@@ -0,0 +1,72 @@
+#include "tsp_anneal.hpp"
+#include "tsp_solver.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <chrono>
+
+
+int main() {
+    /* the running cost of a chain follows its moves exactly */
+    auto big = euclidean(150, 3);
+    ds::tsp_neighbor_matrix m(big, 10);
+    ds::array_list<int> tour;
+    for (int i = 0; i < 150; ++i) {
+        tour.push_back(i);
+    }
+    ds::tsp_anneal_chain chain(m, 42);
+    chain.reset(tour, m.cycle_cost(tour));
+    for (double temperature : {500.0, 50.0, 5.0}) {
+        chain.run(20000, temperature);
+        if (chain.best_cost() != m.cycle_cost(chain.best()) || chain.best().size() != 150) {
+            return 1;
+        }
+    }
+
+    /* small instances are solved to optimality */
+    auto small = euclidean(12, 5);
+    auto exact = small.tsp_bnb_v2(0, ds::tsp_budget());
+    auto annealed = ds::tsp_solve(small, 0, ds::tsp_algorithm::annealing);
+    if (annealed.cost != exact.cost || !is_tour(annealed.tour, 12, 0) || tour_cost(small, annealed.tour) != annealed.cost) {
+        return 1;
+    }
+
+    /* with a fixed number of chains the result does not depend on the threads */
+    ds::tsp_anneal_params params;
+    params.chains = 4;
+    params.epochs = 20;
+    params.threads = 1;
+    auto one = ds::tsp_anneal(big, 7, params);
+    params.threads = 4;
+    auto four = ds::tsp_anneal(big, 7, params);
+    if (one.cost != four.cost || !is_tour(one.tour, 150, 7) || tour_cost(big, one.tour) != one.cost ||
+        one.status != ds::tsp_status::heuristic || one.lower_bound > one.cost) {
+        return 1;
+    }
+    for (int i = 0; i < one.tour.size(); ++i) {
+        if (one.tour[i] != four.tour[i]) {
+            return 1;
+        }
+    }
+
+    /* a run until the deadline ends as a finished heuristic */
+    params.epochs = 0;
+    auto start = std::chrono::steady_clock::now();
+    auto timed = ds::tsp_anneal(big, 0, params, ds::tsp_budget::within(std::chrono::milliseconds(100)));
+    if (timed.status != ds::tsp_status::heuristic || !is_tour(timed.tour, 150, 0) ||
+        std::chrono::steady_clock::now() - start > std::chrono::seconds(5)) {
+        return 1;
+    }
+
+    /* a stop request ends it early */
+    ds::tsp_stop_source source;
+    source.request_stop();
+    auto budget = ds::tsp_budget::unlimited();
+    budget.stop = source.get_token();
+    auto stopped = ds::tsp_anneal(big, 0, params, budget);
+    if (stopped.status != ds::tsp_status::cancelled || !stopped.has_tour()) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#include "tsp_async.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <chrono>
+
+
+int main() {
+    auto m = graph5();
+    ds::undirected_graph g(m);
+
+    auto small = ds::tsp_solve_async(g, 0, ds::tsp_algorithm::branch_and_bound);
+    if (!small.valid() || !small.wait_for(std::chrono::seconds(10))) {
+        return 1;
+    }
+
+    auto result = small.get();
+    if (!result.optimal() || result.cost != 13 || small.valid()) {
+        return 1;
+    }
+
+    /* brute force on 13 vertices runs for hours, cancel it */
+    auto big = random_symmetric(13, 1, 100);
+
+    auto slow = ds::tsp_solve_async(ds::undirected_graph(big), 0, ds::tsp_algorithm::brute_force);
+    if (slow.wait_for(std::chrono::milliseconds(20))) {
+        return 1;
+    }
+
+    slow.cancel();
+    if (!slow.wait_for(std::chrono::seconds(10))) {
+        return 1;
+    }
+
+    auto cancelled = slow.get();
+    if (cancelled.status != ds::tsp_status::cancelled || cancelled.lower_bound > cancelled.cost) {
+        return 1;
+    }
+
+    /* a dropped task is cancelled instead of blocking until it finishes */
+    {
+        auto abandoned = ds::tsp_solve_async(ds::undirected_graph(big), 0, ds::tsp_algorithm::brute_force);
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "tsp_bound.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+
+/* A policy follows a path and back, its bounds stay below the tour through that path */
+template <class Bound>
+bool follows(const ds::undirected_graph::matrix &m, const ds::array_list<int> &tour, int optimum) {
+    Bound bound;
+    bound.initialize(m, tour[0]);
+    ds::array_list<int> bounds;
+    bounds.push_back(bound.bound());
+
+    int n = m.size();
+    int cost = 0;
+    for (int i = 0; i + 1 < n; ++i) {
+        cost += m[tour[i]][tour[i + 1]];
+        bound.extend(tour[i], tour[i + 1]);
+        bounds.push_back(bound.bound());
+    }
+    if (bound.bound() > cost + m[tour[n - 1]][tour[0]]) {
+        return false;
+    }
+    for (int i = n - 2; i >= 0; --i) {
+        if (bounds[i + 1] > optimum) {
+            return false;
+        }
+        bound.retract(tour[i], tour[i + 1]);
+        if (bound.bound() != bounds[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class Bound>
+bool solves(ds::undirected_graph &g, int start, int optimum) {
+    ds::tsp_stats stats;
+    auto result = g.tsp_bnb<Bound>(start, ds::tsp_budget(), stats);
+    return result.optimal() && result.cost == optimum && is_tour(result.tour, g.vertices_size(), start) &&
+           stats.nodes_expanded + stats.nodes_pruned == stats.nodes_generated + 1;
+}
+
+
+int main() {
+    for (int n = 3; n <= 11; ++n) {
+        auto m = random_symmetric(n, 5 + n, 100);
+        ds::undirected_graph g(m);
+        auto exact = g.tsp_small(0, ds::tsp_budget());
+
+        /* every policy finds the optimum from any start */
+        for (int start : {0, n / 2, n - 1}) {
+            if (!solves<ds::tsp_min_adjacent_bound>(g, start, exact.cost) ||
+                !solves<ds::tsp_half_sum_bound>(g, start, exact.cost) ||
+                !solves<ds::tsp_reduced_cost_bound>(g, start, exact.cost)) {
+                return 1;
+            }
+        }
+
+        /* the optimal tour in its searched orientation is never cut off */
+        auto tour = exact.tour;
+        if (n > 2 && tour[1] > tour[n - 1]) {
+            for (int i = 1, j = n - 1; i < j; ++i, --j) {
+                std::swap(tour[i], tour[j]);
+            }
+        }
+        if (!follows<ds::tsp_min_adjacent_bound>(m, tour, exact.cost) ||
+            !follows<ds::tsp_half_sum_bound>(m, tour, exact.cost) ||
+            !follows<ds::tsp_reduced_cost_bound>(m, tour, exact.cost)) {
+            return 1;
+        }
+    }
+
+    /* the default solver is the min adjacent edge policy */
+    ds::undirected_graph g(random_symmetric(10, 5, 100));
+    ds::tsp_stats v2_stats, policy_stats;
+    auto v2 = g.tsp_bnb_v2(3, ds::tsp_budget(), v2_stats);
+    auto policy = g.tsp_bnb<ds::tsp_min_adjacent_bound>(3, ds::tsp_budget(), policy_stats);
+    if (v2.cost != policy.cost || v2_stats.nodes_expanded != policy_stats.nodes_expanded) {
+        return 1;
+    }
+
+    /* a budget stop still reports a lower bound below the optimum */
+    auto stopped = g.tsp_bnb<ds::tsp_reduced_cost_bound>(3, ds::tsp_budget::nodes(5));
+    if (stopped.status != ds::tsp_status::node_limit || stopped.lower_bound > v2.cost) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "tsp_cache.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <cstdio>
+#include <string>
+
+
+int main() {
+    auto m = graph5();
+    ds::undirected_graph g(m);
+
+    auto changed = m;
+    changed[1][2] = changed[2][1] = 2;
+    ds::undirected_graph h(changed);
+
+    /* equal instances share a key, any change gives another one */
+    if (ds::tsp_cache::key(g, 0) != ds::tsp_cache::key(ds::undirected_graph(m), 0) ||
+        ds::tsp_cache::key(g, 0) == ds::tsp_cache::key(g, 1) ||
+        ds::tsp_cache::key(g, 0) == ds::tsp_cache::key(h, 0)) {
+        return 1;
+    }
+
+    const std::string spill_path = "tsp_cache_test.spill";
+    std::remove(spill_path.c_str());
+
+    {
+        ds::tsp_cache cache(2, spill_path);
+        ds::tsp_result found;
+
+        if (cache.find(ds::tsp_cache::key(g, 0), found) || cache.misses() != 1) {
+            return 1;
+        }
+
+        auto solved = g.tsp_bnb_v2(0, ds::tsp_budget());
+        cache.insert(ds::tsp_cache::key(g, 0), solved);
+        if (!cache.find(ds::tsp_cache::key(g, 0), found) || found.cost != 13 || found.tour.size() != 6) {
+            return 1;
+        }
+
+        /* results of a budgeted search that did not finish are not stored */
+        ds::tsp_result partial = solved;
+        partial.status = ds::tsp_status::time_limit;
+        cache.insert(ds::tsp_cache::key(h, 0), partial);
+        if (cache.size() != 1) {
+            return 1;
+        }
+
+        /* the third result evicts the least recently used one to the spill file */
+        cache.insert(ds::tsp_cache::key(g, 1), g.tsp_bnb_v2(1, ds::tsp_budget()));
+        cache.insert(ds::tsp_cache::key(h, 0), h.tsp_bnb_v2(0, ds::tsp_budget()));
+        if (cache.size() != 2 || cache.spilled() != 1) {
+            return 1;
+        }
+
+        if (!cache.find(ds::tsp_cache::key(g, 0), found) || found.cost != 13 || !found.optimal()) {
+            return 1;
+        }
+    }
+
+    /* a new cache finds the evicted results and the ones left in memory */
+    {
+        ds::tsp_cache cache(2, spill_path);
+        ds::tsp_result found;
+        if (cache.spilled() != 3 || !cache.find(ds::tsp_cache::key(g, 0), found) || found.cost != 13) {
+            return 1;
+        }
+        for (int i = 0; i < found.tour.size(); ++i) {
+            if (found.tour[i] != g.tsp_bnb_v2(0).second[i]) {
+                return 1;
+            }
+        }
+    }
+
+    std::remove(spill_path.c_str());
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "tsp_cluster.hpp"
+#include "tsp_solver.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+#include <chrono>
+
+
+int main() {
+    /* k-medoids puts every vertex in exactly one cluster, with its medoid */
+    auto big = euclidean(600, 11);
+    ds::thread_pool pool(3);
+    auto clustering = ds::tsp_k_medoids(big, 10, 5, 1, pool);
+    if (clustering.medoids.size() == 0 || clustering.medoids.size() > 10 ||
+        clustering.members.size() != clustering.medoids.size()) {
+        return 1;
+    }
+    ds::array_list<int> owners(600, 0);
+    for (int c = 0; c < clustering.members.size(); ++c) {
+        bool has_medoid = false;
+        for (int i = 0; i < clustering.members[c].size(); ++i) {
+            ++owners[clustering.members[c][i]];
+            has_medoid = has_medoid || clustering.members[c][i] == clustering.medoids[c];
+        }
+        if (!has_medoid) {
+            return 1;
+        }
+    }
+    for (int v = 0; v < 600; ++v) {
+        if (owners[v] != 1) {
+            return 1;
+        }
+    }
+
+    /* on the calling thread the clusters are the same */
+    ds::tsp_workers caller(1);
+    auto serial = ds::tsp_k_medoids(big, 10, 5, 1, caller);
+    if (serial.medoids.size() != clustering.medoids.size()) {
+        return 1;
+    }
+    for (int c = 0; c < serial.medoids.size(); ++c) {
+        if (serial.medoids[c] != clustering.medoids[c] || serial.members[c].size() != clustering.members[c].size()) {
+            return 1;
+        }
+    }
+
+    /* the stitched tour is close to a tour of the whole graph */
+    ds::tsp_cluster_params params;
+    params.cluster_size = 60;
+    params.threads = 1;
+    auto one = ds::tsp_cluster_solve(big, 5, params);
+    auto whole = ds::tsp_solve(big, 5, ds::tsp_algorithm::annealing);
+    if (!is_tour(one.tour, 600, 5) || tour_cost(big, one.tour) != one.cost ||
+        one.status != ds::tsp_status::heuristic || one.lower_bound > one.cost ||
+        one.cost > whole.cost + whole.cost / 5) {
+        return 1;
+    }
+
+    /* the stats time the whole solve, every cluster solve is a node next to the repair */
+    ds::tsp_stats stats;
+    auto begin = std::chrono::steady_clock::now();
+    auto timed = ds::tsp_cluster_solve(big, 5, params, ds::tsp_budget(), stats);
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+    if (timed.cost != one.cost || stats.total_time < elapsed / 2 || stats.total_time > elapsed ||
+        stats.nodes_expanded <= clustering.medoids.size()) {
+        return 1;
+    }
+
+    /* the result does not depend on the threads */
+    params.threads = 4;
+    auto four = ds::tsp_cluster_solve(big, 5, params);
+    if (four.cost != one.cost) {
+        return 1;
+    }
+    for (int i = 0; i < one.tour.size(); ++i) {
+        if (one.tour[i] != four.tour[i]) {
+            return 1;
+        }
+    }
+
+    /* clusters small enough for the dp, and a graph that is one cluster */
+    params.cluster_size = 12;
+    auto medium = euclidean(100, 4);
+    auto small_clusters = ds::tsp_cluster_solve(medium, 0, params);
+    if (!is_tour(small_clusters.tour, 100, 0) || tour_cost(medium, small_clusters.tour) != small_clusters.cost) {
+        return 1;
+    }
+    auto tiny = euclidean(10, 2);
+    auto exact = tiny.tsp_bnb_v2(0, ds::tsp_budget());
+    auto single = ds::tsp_solve(tiny, 0, ds::tsp_algorithm::cluster);
+    if (single.cost != exact.cost || !is_tour(single.tour, 10, 0)) {
+        return 1;
+    }
+
+    /* a stop request still ends with a tour */
+    ds::tsp_stop_source source;
+    source.request_stop();
+    auto budget = ds::tsp_budget::unlimited();
+    budget.stop = source.get_token();
+    auto stopped = ds::tsp_cluster_solve(big, 0, params, budget);
+    if (stopped.status != ds::tsp_status::cancelled || !is_tour(stopped.tour, 600, 0)) {
+        return 1;
+    }
+
+    return 0;
+}
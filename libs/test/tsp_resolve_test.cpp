@@ -0,0 +1,66 @@
+#include "tsp_resolve.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+
+int main() {
+    const int n = 10;
+    auto m = random_symmetric(n, 7, 100);
+    ds::undirected_graph g(m);
+
+    auto previous = g.tsp_bnb_v2(0, ds::tsp_budget());
+
+    /* make two edges of the optimal tour expensive */
+    ds::array_list<ds::undirected_graph::edge_type> changed = {
+        {previous.tour[1], previous.tour[2]},
+        {previous.tour[5], previous.tour[6]}
+    };
+    for (int i = 0; i < changed.size(); ++i) {
+        g.set_edge_weight(changed[i], 500);
+    }
+    if (g.edge_weight({changed[0].second, changed[0].first}) != 500) {
+        return 1;
+    }
+
+    auto repaired = ds::tsp_resolve(g, previous, changed, ds::tsp_resolve_mode::repair);
+    if (!is_tour(repaired.tour, n, 0) || repaired.cost != tour_cost(g, repaired.tour) ||
+        repaired.cost >= tour_cost(g, previous.tour) || repaired.lower_bound > repaired.cost) {
+        return 1;
+    }
+
+    ds::tsp_stats cold_stats;
+    auto cold = g.tsp_bnb_v2(0, ds::tsp_budget(), cold_stats);
+
+    /* the warm start prunes with a good incumbent from the first node on */
+    ds::tsp_stats warm_stats;
+    auto warm = ds::tsp_resolve(g, previous, changed, ds::tsp_resolve_mode::exact, ds::tsp_budget(), warm_stats);
+    if (!warm.optimal() || warm.cost != cold.cost || !is_tour(warm.tour, n, 0) ||
+        warm_stats.nodes_expanded > cold_stats.nodes_expanded) {
+        return 1;
+    }
+
+    /* the node limit covers the repair and the branch and bound together */
+    ds::array_list<int> focus;
+    for (int i = 0; i < changed.size(); ++i) {
+        focus.push_back(changed[i].first);
+        focus.push_back(changed[i].second);
+    }
+    ds::tsp_stats repair_stats;
+    ds::tsp_two_opt_repair(g, previous.tour, focus, ds::tsp_budget(), repair_stats);
+    const std::size_t limit = repair_stats.nodes_expanded + 2;
+    ds::tsp_stats limited_stats;
+    auto limited = ds::tsp_resolve(g, previous, changed, ds::tsp_resolve_mode::exact, ds::tsp_budget::nodes(limit), limited_stats);
+    if (repair_stats.nodes_expanded == 0 || limited.status != ds::tsp_status::node_limit ||
+        limited_stats.nodes_expanded > 2 || !is_tour(limited.tour, n, 0)) {
+        return 1;
+    }
+
+    /* an invalid warm start tour is ignored */
+    ds::tsp_budget budget;
+    budget.initial_tour = {0, 1, 1, 0};
+    if (g.tsp_bnb_v2(0, budget).cost != cold.cost) {
+        return 1;
+    }
+
+    return 0;
+}
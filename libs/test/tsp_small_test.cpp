@@ -0,0 +1,50 @@
+#include "tsp_solver.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+
+int main() {
+    /* every fixed size agrees with branch and bound, from any start */
+    for (int n = 2; n <= 17; ++n) {
+        ds::undirected_graph g(random_symmetric(n, 11 + n, 100));
+        int start = n / 2;
+
+        ds::tsp_stats stats;
+        auto small = g.tsp_small(start, ds::tsp_budget(), stats);
+        auto bnb = g.tsp_bnb_v2(start, ds::tsp_budget());
+
+        if (!small.optimal() || small.cost != bnb.cost || small.lower_bound != small.cost ||
+            !is_tour(small.tour, n, start) || tour_cost(g, small.tour) != small.cost) {
+            return 1;
+        }
+
+        /* above the fixed sizes tsp_small is branch and bound */
+        if (n <= ds::undirected_graph::SMALL_TSP_MAX_VERTICES && stats.nodes_expanded != (1u << (n - 1)) - 1) {
+            return 1;
+        }
+    }
+
+    auto m = graph5();
+    ds::undirected_graph g(m);
+
+    auto [small_cost, small_tour] = g.tsp_small(0);
+    if (small_cost != 13 || small_tour.size() != 6) {
+        return 1;
+    }
+
+    auto solved = ds::tsp_solve(g, 0, ds::tsp_algorithm::small);
+    if (!solved.optimal() || solved.cost != 13) {
+        return 1;
+    }
+
+    /* a stopped dp keeps the warm start tour and proves no bound */
+    auto budget = ds::tsp_budget::nodes(3);
+    budget.initial_tour = {0, 1, 2, 3, 4, 0};
+    auto limited = g.tsp_small(0, budget);
+    if (limited.status != ds::tsp_status::node_limit || limited.cost != 4 + 1 + 2 + 6 + 3 ||
+        limited.lower_bound != 0) {
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+/*****************************************************************
+ * Helpers shared by the tsp solver tests
+ *****************************************************************/
+#pragma once
+#ifndef TSP_TEST_UTIL_HPP
+#define TSP_TEST_UTIL_HPP
+
+#include "undirected_graph.hpp"
+#include "array_list.hpp"
+
+#include <cmath>
+#include <random>
+
+/* Check that tour visits each of the n vertices once, from start back to start */
+inline bool is_tour(const ds::array_list<int> &tour, int n, int start) {
+    if (tour.size() != n + 1 || tour[0] != start || tour[n] != start) {
+        return false;
+    }
+    ds::array_list<bool> seen(n, false);
+    for (int i = 0; i < n; ++i) {
+        if (seen[tour[i]]) {
+            return false;
+        }
+        seen[tour[i]] = true;
+    }
+    return true;
+}
+
+inline int tour_cost(ds::undirected_graph &g, const ds::array_list<int> &tour) {
+    int cost = 0;
+    for (int i = 0; i + 1 < tour.size(); ++i) {
+        cost += g.edge_weight({tour[i], tour[i + 1]});
+    }
+    return cost;
+}
+
+/* The 5 vertex graph of the small tests, its optimal tour costs 13 */
+inline ds::undirected_graph::matrix graph5() {
+    return {
+        {0, 4, 8, 2, 3},
+        {4, 0, 1, 6, 5},
+        {8, 1, 0, 2, 1},
+        {2, 6, 2, 0, 6},
+        {3, 5, 1, 6, 0}
+    };
+}
+
+/* Random symmetric costs between 1 and high, 0 on the diagonal */
+inline ds::undirected_graph::matrix random_symmetric(int n, unsigned seed, int high) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> cost(1, high);
+    ds::undirected_graph::matrix m(n, ds::array_list<int>(n, 0));
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            m[i][j] = m[j][i] = cost(rng);
+        }
+    }
+    return m;
+}
+
+/* Random points in a square, rounded euclidean distances */
+inline ds::undirected_graph euclidean(int n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    ds::array_list<double> x(n, 0.0), y(n, 0.0);
+    for (int i = 0; i < n; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+    }
+    ds::undirected_graph::matrix m(n, ds::array_list<int>(n, 0));
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            m[i][j] = i == j ? 0 : 1 + static_cast<int>(std::hypot(x[i] - x[j], y[i] - y[j]));
+        }
+    }
+    return ds::undirected_graph(m);
+}
+
+#endif
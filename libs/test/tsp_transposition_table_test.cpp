@@ -0,0 +1,42 @@
+#include "tsp_transposition_table.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_test_util.hpp"
+
+
+int main() {
+    /* too small to be worth a table */
+    ds::tsp_transposition_table none(3, 4);
+    if (none.enabled() || !none.improve(7, 1, 10, 3)) {
+        return 1;
+    }
+
+    ds::tsp_transposition_table table(10, 4);
+    if (!table.enabled()) {
+        return 1;
+    }
+
+    /* the current vertex is part of the state, a prefix is dominated unless it is cheaper */
+    if (!table.improve(0b111, 2, 10, 3) || !table.improve(0b111, 1, 12, 3)) {
+        return 1;
+    }
+    if (table.improve(0b111, 2, 10, 3) || table.improve(0b111, 2, 11, 3) || !table.improve(0b111, 2, 9, 3)) {
+        return 1;
+    }
+
+    /* filling the table evicts entries but never reports a false dominance */
+    for (int i = 0; i < 1000; ++i) {
+        if (!table.improve(static_cast<ds::tsp_transposition_table::mask_type>(i) << 10, i % 10, 100, i % 10 + 1)) {
+            return 1;
+        }
+    }
+
+    /* branch and bound still finds the brute force optimum */
+    for (int n = 4; n <= 9; ++n) {
+        ds::undirected_graph g(random_symmetric(n, 3 + n, 50));
+        if (g.tsp_bnb_v2(0).first != g.tsp_brute_force(0).first) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
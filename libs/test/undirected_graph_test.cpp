@@ -1,10 +1,300 @@
 #include "undirected_graph.hpp"
 #include "array_list.hpp"
+#include "tsp_test_util.hpp"
 
 #include <iostream>
+#include <limits>
 
 
 int main() {
-    
+    auto m = graph5();
+    ds::undirected_graph g(m);
+
+    auto [bf_cost, bf_tour] = g.tsp_brute_force(0);
+    auto [bnb_cost, bnb_tour] = g.tsp_bnb_v2(0);
+
+    if (bf_cost != 13 || bnb_cost != 13) {
+        return 1;
+    }
+
+    if (bnb_tour.size() != 6 || bnb_tour.front() != 0 || bnb_tour.back() != 0) {
+        return 1;
+    }
+
+    /* plain branch and bound, without finishing small subtrees by dp */
+    ds::tsp_budget no_dp;
+    no_dp.dp_threshold = 0;
+
+    ds::tsp_stats bf_stats;
+    ds::tsp_stats bnb_stats;
+    g.tsp_brute_force(0, bf_stats);
+    g.tsp_bnb_v2(0, no_dp, bnb_stats);
+
+    /* 1 + 4 + 4*3 + 4*3*2 + 4*3*2*1 nodes in the full permutation tree */
+    if (bf_stats.nodes_expanded != 65 || bf_stats.nodes_generated != 64 || bf_stats.nodes_pruned != 0) {
+        return 1;
+    }
+
+    if (bnb_stats.nodes_expanded + bnb_stats.nodes_pruned != bnb_stats.nodes_generated + 1) {
+        return 1;
+    }
+
+    if (bnb_stats.nodes_expanded >= bf_stats.nodes_expanded || bnb_stats.incumbents.empty() ||
+        bnb_stats.incumbents.back().cost != 13 || bnb_stats.max_depth != 5) {
+        return 1;
+    }
+
+    ds::undirected_graph::matrix m13 = {
+        {0, 2451, 713, 1018, 1631, 1374, 2408, 213, 2571, 875, 1420, 2145, 1972},
+        {2451, 0, 1745, 1524, 831, 1240, 959, 2596, 403, 1589, 1374, 357, 579},
+        {713, 1745, 0, 355, 920, 803, 1737, 851, 1858, 262, 940, 1453, 1260},
+        {1018, 1524, 355, 0, 700, 862, 1395, 1123, 1584, 466, 1056, 1280, 987},
+        {1631, 831, 920, 700, 0, 663, 1021, 1769, 949, 796, 879, 586, 371},
+        {1374, 1240, 803, 862, 663, 0, 1681, 1551, 1765, 547, 225, 887, 999},
+        {2408, 959, 1737, 1395, 1021, 1681, 0, 2493, 678, 1724, 1891, 1114, 701},
+        {213, 2596, 851, 1123, 1769, 1551, 2493, 0, 2699, 1038, 1605, 2300, 2099},
+        {2571, 403, 1858, 1584, 949, 1765, 678, 2699, 0, 1744, 1645, 653, 600},
+        {875, 1589, 262, 466, 796, 547, 1724, 1038, 1744, 0, 679, 1272, 1162},
+        {1420, 1374, 940, 1056, 879, 225, 1891, 1605, 1645, 679, 0, 1017, 1200},
+        {2145, 357, 1453, 1280, 586, 887, 1114, 2300, 653, 1272, 1017, 0, 504},
+        {1972, 579, 1260, 987, 371, 999, 701, 2099, 600, 1162, 1200, 504, 0}
+    };
+    ds::undirected_graph h(m13);
+
+    /* A node limit stops the search early with a valid bound */
+    int improvements = 0;
+    auto budget = ds::tsp_budget::nodes(50);
+    budget.dp_threshold = 0;
+    budget.on_improvement = [&improvements](int, const ds::array_list<int> &) { ++improvements; };
+    ds::tsp_stats limited_stats;
+    auto limited = h.tsp_bnb_v2(0, budget, limited_stats);
+
+    if (limited.status != ds::tsp_status::node_limit || limited_stats.nodes_expanded != 50 ||
+        !limited.has_tour() || limited.lower_bound > limited.cost || limited.gap() < 0 ||
+        improvements == 0 || improvements != limited_stats.incumbents.size()) {
+        return 1;
+    }
+
+    /* A deadline in the past stops before the first node */
+    auto expired = h.tsp_brute_force(0, ds::tsp_budget::within(std::chrono::milliseconds(0)));
+    if (expired.status != ds::tsp_status::time_limit || expired.has_tour() || expired.gap() != 1.0) {
+        return 1;
+    }
+
+    auto full = g.tsp_bnb_v2(0, ds::tsp_budget::unlimited());
+    if (!full.optimal() || full.cost != 13 || full.lower_bound != 13 || full.gap() != 0) {
+        return 1;
+    }
+
+    /* the dp takes over below the threshold and agrees with the plain search */
+    auto plain = h.tsp_bnb_v2(0, no_dp);
+
+    /* only one orientation of every tour is searched */
+    if (!plain.optimal() || plain.tour[1] >= plain.tour[12]) {
+        return 1;
+    }
+    for (std::size_t k : {2, 5, 9, 13}) {
+        ds::tsp_budget hybrid_budget;
+        hybrid_budget.dp_threshold = k;
+        ds::tsp_stats hybrid_stats;
+        auto hybrid = h.tsp_bnb_v2(0, hybrid_budget, hybrid_stats);
+
+        if (!hybrid.optimal() || hybrid.cost != plain.cost || hybrid.tour.size() != 14 ||
+            hybrid_stats.max_depth > 14 - k) {
+            return 1;
+        }
+    }
+
+    /* batch path costs agree with a plain sum, every length around the 8 wide steps */
+    ds::array_list<ds::array_list<int>> paths;
+    for (int length = 0; length < 40; ++length) {
+        ds::array_list<int> path;
+        for (int i = 0; i < length; ++i) {
+            path.push_back((i * 7 + length) % 13);
+        }
+        paths.push_back(path);
+    }
+    for (std::size_t threads : {1, 3}) {
+        auto costs = h.path_costs(paths, threads);
+        if (costs.size() != paths.size()) {
+            return 1;
+        }
+        for (int t = 0; t < paths.size(); ++t) {
+            int expected = 0;
+            for (int i = 0; i + 1 < paths[t].size(); ++i) {
+                expected += h.edge_weight({paths[t][i], paths[t][i + 1]});
+            }
+            if (costs[t] != expected) {
+                return 1;
+            }
+        }
+    }
+
+    /* the minimum spanning tree and the 1-tree of the small graph */
+    auto tree = g.mst(0);
+    if (tree.first != 6 || tree.second[0] != -1 || tree.second[1] != 2 || tree.second[4] != 2) {
+        return 1;
+    }
+    auto one = g.one_tree(0);
+    if (one.first != 9 || one.second.size() != 5 || one.first > bnb_cost) {
+        return 1;
+    }
+
+    /* on the larger graph the tree spans every vertex whatever the root */
+    for (int root : {0, 7, 12}) {
+        auto spanning = h.mst(root);
+        int weight = 0;
+        for (int v = 0; v < 13; ++v) {
+            int steps = 0;
+            for (int u = v; u != root && steps <= 13; u = spanning.second[u], ++steps) {}
+            if (spanning.second[v] >= 0) {
+                weight += h.edge_weight({v, spanning.second[v]});
+            }
+            if (steps > 13 || (v == root) != (spanning.second[v] == -1)) {
+                return 1;
+            }
+        }
+        if (weight != spanning.first || weight != h.mst(0).first) {
+            return 1;
+        }
+        if (h.one_tree(root).first > plain.cost) {
+            return 1;
+        }
+    }
+
+    /* a vertex without edges leaves the graph unconnected */
+    ds::undirected_graph::matrix island = {
+        {0, 3, 4, 0},
+        {3, 0, 5, 0},
+        {4, 5, 0, 0},
+        {0, 0, 0, 0}
+    };
+    ds::undirected_graph apart(island);
+    if (apart.mst(0).first != std::numeric_limits<int>::max() || apart.one_tree(3).first != std::numeric_limits<int>::max()) {
+        return 1;
+    }
+
+    /* the metric closure of a sparse graph over several blocks matches plain Floyd-Warshall */
+    const int sparse_size = 150;
+    ds::undirected_graph::matrix sparse(sparse_size, ds::array_list<int>(sparse_size, 0));
+    for (int i = 0; i < sparse_size; ++i) {
+        for (int j = i + 1; j < sparse_size; ++j) {
+            if ((i * 31 + j * 17) % 23 == 0 || j == i + 1) {
+                sparse[i][j] = sparse[j][i] = 1 + (i * 7 + j * 13) % 50;
+            }
+        }
+    }
+    sparse[40][41] = sparse[41][40] = 0;
+    auto shortest = sparse;
+    const int far = std::numeric_limits<int>::max() / 2;
+    for (int i = 0; i < sparse_size; ++i) {
+        for (int j = 0; j < sparse_size; ++j) {
+            shortest[i][j] = i == j ? 0 : (sparse[i][j] == 0 ? far : sparse[i][j]);
+        }
+    }
+    for (int k = 0; k < sparse_size; ++k) {
+        for (int i = 0; i < sparse_size; ++i) {
+            for (int j = 0; j < sparse_size; ++j) {
+                shortest[i][j] = std::min(shortest[i][j], shortest[i][k] + shortest[k][j]);
+            }
+        }
+    }
+    for (std::size_t threads : {1, 3}) {
+        ds::undirected_graph closed(sparse);
+        auto next = closed.metric_closure(threads);
+        for (int i = 0; i < sparse_size; ++i) {
+            for (int j = 0; j < sparse_size; ++j) {
+                int expected = i == j || shortest[i][j] == far ? 0 : shortest[i][j];
+                if (closed.edge_weight({i, j}) != expected) {
+                    return 1;
+                }
+            }
+        }
+
+        /* a path over the closure expands to real edges of the same cost */
+        ds::array_list<int> hops = {0, 149, 75, 3, 0};
+        auto expanded = ds::undirected_graph::expand_path(hops, next);
+        int closed_cost = 0;
+        int real_cost = 0;
+        for (int i = 0; i + 1 < hops.size(); ++i) {
+            closed_cost += closed.edge_weight({hops[i], hops[i + 1]});
+        }
+        for (int i = 0; i + 1 < expanded.size(); ++i) {
+            if (sparse[expanded[i]][expanded[i + 1]] == 0) {
+                return 1;
+            }
+            real_cost += sparse[expanded[i]][expanded[i + 1]];
+        }
+        if (expanded.front() != 0 || expanded.back() != 0 || real_cost != closed_cost) {
+            return 1;
+        }
+    }
+
+    /* pairs without a path stay unreachable */
+    ds::undirected_graph split(island);
+    auto split_next = split.metric_closure();
+    if (split.edge_weight({0, 3}) != 0 || split.edge_weight({1, 2}) != 5 || split_next[0][3] != -1 ||
+        !ds::undirected_graph::expand_path({0, 3}, split_next).empty()) {
+        return 1;
+    }
+
+    /* shortest paths from two sources agree with the closure, with either heap */
+    ds::undirected_graph roads(sparse);
+    auto adjacency = roads.adjacency();
+    ds::array_list<int> depots = {0, 100};
+    auto by_heap = roads.shortest_paths(depots, adjacency);
+    auto by_radix = roads.shortest_paths_radix(depots, adjacency);
+    for (int v = 0; v < sparse_size; ++v) {
+        int expected = std::min(shortest[0][v], shortest[100][v]);
+        expected = expected == far ? std::numeric_limits<int>::max() : expected;
+        if (by_heap.first[v] != expected || by_radix.first[v] != expected) {
+            return 1;
+        }
+        for (const auto &paths : {by_heap, by_radix}) {
+            int p = paths.second[v];
+            if (p >= 0 && paths.first[p] + sparse[p][v] != paths.first[v]) {
+                return 1;
+            }
+        }
+    }
+    auto single = roads.shortest_paths(7);
+    if (single.first[7] != 0 || single.second[7] != -1 || single.first[149] != shortest[7][149]) {
+        return 1;
+    }
+
+    /* cached statistics follow edge mutations as if recomputed from the matrix */
+    if (g.edges_size() != 10 || g.vertex_degree(2) != 4 || g.min_edge_weight() != 1 ||
+        g.min_adjacent_edge(0) != 2 || g.second_min_adjacent_edge(0) != 3) {
+        return 1;
+    }
+    ds::undirected_graph mutated(sparse);
+    auto mirror = sparse;
+    for (int step = 0; step < 3000; ++step) {
+        int a = (step * 37 + 11) % sparse_size;
+        int b = (step * 53 + 5) % sparse_size;
+        int weight = step % 4 == 0 ? 0 : 1 + (step * 29) % 60;
+        if (step % 7 == 0) {
+            mutated.remove_edge({a, b});
+            weight = 0;
+        } else {
+            mutated.set_edge_weight({a, b}, weight);
+        }
+        mirror[a][b] = mirror[b][a] = weight;
+
+        if (step % 250 == 0 || step == 2999) {
+            ds::undirected_graph fresh(mirror);
+            if (mutated.edges_size() != fresh.edges_size() || mutated.min_edge_weight() != fresh.min_edge_weight()) {
+                return 1;
+            }
+            for (int v = 0; v < sparse_size; ++v) {
+                if (mutated.vertex_degree(v) != fresh.vertex_degree(v) ||
+                    mutated.min_adjacent_edge(v) != fresh.min_adjacent_edge(v) ||
+                    mutated.second_min_adjacent_edge(v) != fresh.second_min_adjacent_edge(v)) {
+                    return 1;
+                }
+            }
+        }
+    }
+
     return 0;
-}
\ No newline at end of file
+}
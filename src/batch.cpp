@@ -0,0 +1,320 @@
+#include "batch.hpp"
+#include "json.hpp"
+#include "util.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_solver.hpp"
+#include "thread_pool.hpp"
+#include "array_list.hpp"
+#include "sort.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <mutex>
+#include <filesystem>
+
+namespace batch {
+    namespace {
+        namespace fs = std::filesystem;
+
+        bool parse_int(const std::string &s, int &out) {
+            try {
+                std::size_t pos;
+                out = std::stoi(s, &pos);
+                return pos == s.size();
+            } catch (const std::exception &) {
+                return false;
+            }
+        }
+
+        /* Match a file name against a pattern where * is any run and ? any one character */
+        bool wildcard_match(const char *pattern, const char *name) {
+            if (*pattern == '\0') {
+                return *name == '\0';
+            }
+            if (*pattern == '*') {
+                return wildcard_match(pattern + 1, name) || (*name != '\0' && wildcard_match(pattern, name + 1));
+            }
+            if (*name != '\0' && (*pattern == '?' || *pattern == *name)) {
+                return wildcard_match(pattern + 1, name + 1);
+            }
+            return false;
+        }
+
+        bool has_wildcard(const std::string &s) {
+            return s.find_first_of("*?") != std::string::npos;
+        }
+
+        std::string tour_string(const ds::array_list<int> &tour) {
+            std::string ret;
+            for (int i = 0; i < tour.size(); ++i) {
+                if (i > 0) {
+                    ret += '-';
+                }
+                ret += std::to_string(tour[i]);
+            }
+            return ret;
+        }
+
+        /* A csv field, quoted when it holds a separator, a quote or a line break */
+        std::string csv_field(const std::string &s) {
+            if (s.find_first_of(",\"\r\n") == std::string::npos) {
+                return s;
+            }
+            std::string ret = "\"";
+            for (const auto &c : s) {
+                if (c == '"') {
+                    ret += '"';
+                }
+                ret += c;
+            }
+            return ret + "\"";
+        }
+
+        /* Result line of one instance, or the reason it could not be solved */
+        struct line {
+            std::string file;
+            std::string error;
+            std::size_t vertices = 0;
+            ds::tsp_result result;
+            double time_us = 0;
+            std::size_t nodes = 0;
+        };
+
+        line solve_file(const std::string &file, ds::tsp_algorithm algorithm, const options &opts) {
+            line l;
+            l.file = file;
+
+            auto matrix = util::read_instance_file(file);
+            if (matrix.size() < 2) {
+                l.error = "can not read cost matrix";
+                return l;
+            }
+            for (auto &row : matrix) {
+                if (row.size() != matrix.size()) {
+                    l.error = "cost matrix is not square";
+                    return l;
+                }
+            }
+
+            ds::undirected_graph g(matrix);
+            l.vertices = g.vertices_size();
+
+            auto budget = opts.time_limit_ms > 0
+                ? ds::tsp_budget::within(std::chrono::milliseconds(opts.time_limit_ms))
+                : ds::tsp_budget::unlimited();
+            if (opts.node_limit > 0) {
+                budget.node_limit = opts.node_limit;
+            }
+
+            ds::tsp_stats stats;
+            /* one core per file, the heuristics run on this worker instead of a pool of their own */
+            l.result = ds::tsp_solve(g, 0, algorithm, budget, stats, 1);
+            l.time_us = std::chrono::duration<double, std::micro>(stats.total_time).count();
+            l.nodes = stats.nodes_expanded;
+
+            return l;
+        }
+
+        void write_line(std::ostream &os, const line &l, const options &opts) {
+            if (opts.format == "json") {
+                os << "{\"file\": " << json::quote(l.file) << ", ";
+                if (!l.error.empty()) {
+                    os << "\"error\": " << json::quote(l.error) << "}" << std::endl;
+                    return;
+                }
+                os << "\"n\": " << l.vertices << ", "
+                   << "\"algo\": \"" << opts.algorithm << "\", "
+                   << "\"status\": \"" << ds::tsp_status_name(l.result.status) << "\", "
+                   << "\"cost\": " << l.result.cost << ", "
+                   << "\"lower_bound\": " << l.result.lower_bound << ", "
+                   << "\"gap\": " << l.result.gap() << ", "
+                   << "\"time_us\": " << l.time_us << ", "
+                   << "\"nodes\": " << l.nodes << ", "
+                   << "\"tour\": [";
+                for (int i = 0; i < l.result.tour.size(); ++i) {
+                    os << (i > 0 ? ", " : "") << l.result.tour[i];
+                }
+                os << "]}" << std::endl;
+            } else {
+                if (!l.error.empty()) {
+                    os << csv_field(l.file) << ",,," << csv_field("error: " + l.error) << ",,,,,," << std::endl;
+                    return;
+                }
+                os << csv_field(l.file) << "," << l.vertices << "," << opts.algorithm << ","
+                   << ds::tsp_status_name(l.result.status) << "," << l.result.cost << ","
+                   << l.result.lower_bound << "," << l.result.gap() << ","
+                   << l.time_us << "," << l.nodes << "," << tour_string(l.result.tour) << std::endl;
+            }
+        }
+    }
+
+    void print_usage(std::ostream &os) {
+        os << "Usage: main batch [options] PATH..." << std::endl;
+        os << "  PATH             an instance file, a directory, or a pattern such as data/graph*.txt" << std::endl;
+        os << "  --algo NAME      solver (bf, bnb, small, aco, sa, cluster), default bnb" << std::endl;
+        os << "  --jobs N         worker threads, default one per hardware thread" << std::endl;
+        os << "  --time-limit MS  stop each solve after MS milliseconds" << std::endl;
+        os << "  --node-limit N   stop each solve after N expanded nodes" << std::endl;
+        os << "  --format FMT     csv or json (one object per line), default csv" << std::endl;
+        os << "  --out FILE       write the results to FILE instead of stdout" << std::endl;
+    }
+
+    bool parse_options(int argc, char **argv, options &opts) {
+        for (int i = 0; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--help" || arg == "-h") {
+                return false;
+            }
+
+            if (arg.rfind("--", 0) != 0) {
+                opts.inputs.push_back(arg);
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+
+            bool ok = true;
+            if (arg == "--algo") {
+                ds::tsp_algorithm algorithm;
+                opts.algorithm = value;
+                ok = ds::tsp_algorithm_from_name(value, algorithm);
+            } else if (arg == "--jobs") {
+                ok = parse_int(value, opts.jobs) && opts.jobs > 0;
+            } else if (arg == "--time-limit") {
+                ok = parse_int(value, opts.time_limit_ms) && opts.time_limit_ms > 0;
+            } else if (arg == "--node-limit") {
+                ok = parse_int(value, opts.node_limit) && opts.node_limit > 0;
+            } else if (arg == "--format") {
+                opts.format = value;
+                ok = value == "csv" || value == "json";
+            } else if (arg == "--out") {
+                opts.output = value;
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+
+            if (!ok) {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+        }
+
+        if (opts.inputs.empty()) {
+            std::cerr << "No instance files given" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    ds::array_list<std::string> collect_files(const ds::array_list<std::string> &inputs) {
+        ds::array_list<std::pair<std::uintmax_t, std::string>> found;
+        std::error_code ec;
+
+        auto add = [&found, &ec](const fs::path &p) {
+            if (fs::is_regular_file(p, ec)) {
+                found.push_back(std::make_pair(fs::file_size(p, ec), p.string()));
+            }
+        };
+
+        for (int i = 0; i < inputs.size(); ++i) {
+            fs::path p(inputs[i]);
+
+            if (has_wildcard(p.filename().string())) {
+                auto dir = p.has_parent_path() ? p.parent_path() : fs::path(".");
+                auto pattern = p.filename().string();
+                for (const auto &entry : fs::directory_iterator(dir, ec)) {
+                    if (wildcard_match(pattern.c_str(), entry.path().filename().string().c_str())) {
+                        add(entry.path());
+                    }
+                }
+            } else if (fs::is_directory(p, ec)) {
+                for (const auto &entry : fs::directory_iterator(p, ec)) {
+                    add(entry.path());
+                }
+            } else if (fs::is_regular_file(p, ec)) {
+                add(p);
+            } else {
+                std::cerr << "No such file or directory: " << inputs[i] << std::endl;
+            }
+        }
+
+        /* largest first, file size is a cheap stand-in for the instance size */
+        algo::sort::heap_sort(found.begin(), found.end(), [](const auto &a, const auto &b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+
+        ds::array_list<std::string> ret;
+        for (const auto &f : found) {
+            ret.push_back(f.second);
+        }
+        return ret;
+    }
+
+    int run(int argc, char **argv) {
+        options opts;
+        if (!parse_options(argc, argv, opts)) {
+            print_usage(std::cerr);
+            return 1;
+        }
+
+        ds::tsp_algorithm algorithm;
+        ds::tsp_algorithm_from_name(opts.algorithm, algorithm);
+
+        auto files = collect_files(opts.inputs);
+        if (files.empty()) {
+            std::cerr << "No instance files found" << std::endl;
+            return 1;
+        }
+
+        std::ofstream file;
+        if (!opts.output.empty()) {
+            file.open(opts.output);
+            if (!file.is_open()) {
+                std::cerr << "Can't open file " << opts.output << std::endl;
+                return 1;
+            }
+        }
+        std::ostream &os = opts.output.empty() ? std::cout : file;
+
+        if (opts.format == "csv") {
+            os << "file,n,algo,status,cost,lower_bound,gap,time_us,nodes,tour" << std::endl;
+        }
+
+        std::mutex output_mutex;
+        bool failed = false;
+
+        {
+            ds::thread_pool pool(opts.jobs);
+
+            for (const auto &f : files) {
+                pool.submit([&, f]() {
+                    line l;
+                    try {
+                        l = solve_file(f, algorithm, opts);
+                    } catch (const std::exception &e) {
+                        l.file = f;
+                        l.error = e.what();
+                    }
+
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    failed = failed || !l.error.empty();
+                    write_line(os, l, opts);
+                });
+            }
+
+            pool.wait_idle();
+        }
+
+        return failed ? 1 : 0;
+    }
+}
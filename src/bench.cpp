@@ -0,0 +1,317 @@
+#include "bench.hpp"
+#include "util.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_solver.hpp"
+#include "array_list.hpp"
+#include "sort.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <random>
+#include <cmath>
+
+namespace bench {
+    namespace {
+        ds::array_list<std::string> split(const std::string &s, char delimiter) {
+            ds::array_list<std::string> ret;
+            std::stringstream ssin(s);
+            std::string item;
+            while (std::getline(ssin, item, delimiter)) {
+                if (!item.empty()) {
+                    ret.push_back(item);
+                }
+            }
+            return ret;
+        }
+
+        bool parse_int(const std::string &s, int &out) {
+            try {
+                std::size_t pos;
+                out = std::stoi(s, &pos);
+                return pos == s.size();
+            } catch (const std::exception &) {
+                return false;
+            }
+        }
+
+        /* Accepts "8..14", "8,10,12" or a mix of both such as "5,8..10" */
+        bool parse_sizes(const std::string &s, ds::array_list<int> &sizes) {
+            for (const auto &item : split(s, ',')) {
+                auto range = item.find("..");
+                if (range == std::string::npos) {
+                    int n;
+                    if (!parse_int(item, n) || n < 2) {
+                        return false;
+                    }
+                    sizes.push_back(n);
+                } else {
+                    int from, to;
+                    if (!parse_int(item.substr(0, range), from) || !parse_int(item.substr(range + 2), to) ||
+                        from < 2 || to < from) {
+                        return false;
+                    }
+                    for (int n = from; n <= to; ++n) {
+                        sizes.push_back(n);
+                    }
+                }
+            }
+            return true;
+        }
+
+        /* Nearest-rank percentile of a sorted sample */
+        double percentile(const ds::array_list<double> &sorted, double p) {
+            auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+            return sorted[rank == 0 ? 0 : rank - 1];
+        }
+
+        /* Budget for one solve, the deadline starts counting now */
+        ds::tsp_budget make_budget(const options &opts) {
+            auto budget = opts.time_limit_ms > 0
+                ? ds::tsp_budget::within(std::chrono::milliseconds(opts.time_limit_ms))
+                : ds::tsp_budget::unlimited();
+            if (opts.node_limit > 0) {
+                budget.node_limit = opts.node_limit;
+            }
+            return budget;
+        }
+
+        result measure(ds::tsp_algorithm algorithm, const std::string &instance, const ds::undirected_graph &g, const options &opts) {
+            result r;
+            r.algorithm = ds::tsp_algorithm_name(algorithm);
+            r.instance = instance;
+            r.vertices = g.vertices_size();
+            r.reps = opts.reps;
+            r.nodes = 0;
+            r.cost = 0;
+            r.gap = 0;
+
+            for (int i = 0; i < opts.warmup; ++i) {
+                auto copy = g;
+                ds::tsp_stats stats;
+                ds::tsp_solve(copy, 0, algorithm, make_budget(opts), stats);
+            }
+
+            ds::array_list<double> times;
+            for (int i = 0; i < opts.reps; ++i) {
+                auto copy = g;
+                ds::tsp_stats stats;
+                auto budget = make_budget(opts);
+                auto time = util::bench_time<std::chrono::nanoseconds>([&]() {
+                    auto solved = ds::tsp_solve(copy, 0, algorithm, budget, stats);
+                    r.cost = solved.cost;
+                    r.gap = solved.gap();
+                });
+                times.push_back(time.count() / 1000.0);
+                r.nodes = stats.nodes_expanded;
+            }
+
+            algo::sort::quick_sort_recursive(times.begin(), times.end());
+
+            r.min_us = times[0];
+            r.median_us = times.size() % 2 == 1 ? times[times.size() / 2]
+                : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+            r.p95_us = percentile(times, 95);
+
+            return r;
+        }
+
+        std::string json_escape(const std::string &s) {
+            std::string ret;
+            for (const auto &c : s) {
+                if (c == '"' || c == '\\') {
+                    ret += '\\';
+                }
+                ret += c;
+            }
+            return ret;
+        }
+    }
+
+    void print_usage(std::ostream &os) {
+        os << "Usage: main bench [options]" << std::endl;
+        os << "  --algo LIST      comma separated solvers (bf, bnb, small, aco, sa, cluster), default: all" << std::endl;
+        os << "  --sizes LIST     sizes of random instances, e.g. 8..14 or 5,7,9" << std::endl;
+        os << "  --files LIST     comma separated cost matrix or TSPLIB files" << std::endl;
+        os << "  --reps N         timed repetitions per instance, default 10" << std::endl;
+        os << "  --warmup N       untimed repetitions per instance, default 1" << std::endl;
+        os << "  --seed N         seed for random instances, default 1" << std::endl;
+        os << "  --lb N --hb N    cost bounds for random instances, default 1 and 100" << std::endl;
+        os << "  --time-limit MS  stop each solve after MS milliseconds" << std::endl;
+        os << "  --node-limit N   stop each solve after N expanded nodes" << std::endl;
+        os << "  --format FMT     csv or json, default csv" << std::endl;
+        os << "  --out FILE       write the report to FILE instead of stdout" << std::endl;
+    }
+
+    bool parse_options(int argc, char **argv, options &opts) {
+        for (int i = 0; i < argc; ++i) {
+            std::string arg = argv[i];
+
+            if (arg == "--help" || arg == "-h") {
+                return false;
+            }
+
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+
+            bool ok = true;
+            if (arg == "--algo") {
+                opts.algorithms = split(value, ',');
+                for (const auto &a : opts.algorithms) {
+                    ds::tsp_algorithm algorithm;
+                    if (!ds::tsp_algorithm_from_name(a, algorithm)) {
+                        std::cerr << "Unknown algorithm: " << a << std::endl;
+                        return false;
+                    }
+                }
+            } else if (arg == "--sizes") {
+                ok = parse_sizes(value, opts.sizes);
+            } else if (arg == "--files") {
+                opts.files = split(value, ',');
+            } else if (arg == "--reps") {
+                ok = parse_int(value, opts.reps) && opts.reps > 0;
+            } else if (arg == "--warmup") {
+                ok = parse_int(value, opts.warmup) && opts.warmup >= 0;
+            } else if (arg == "--seed") {
+                int seed;
+                ok = parse_int(value, seed);
+                opts.seed = static_cast<unsigned int>(seed);
+            } else if (arg == "--lb") {
+                ok = parse_int(value, opts.cost_low_bound) && opts.cost_low_bound > 0;
+            } else if (arg == "--hb") {
+                ok = parse_int(value, opts.cost_high_bound);
+            } else if (arg == "--time-limit") {
+                ok = parse_int(value, opts.time_limit_ms) && opts.time_limit_ms > 0;
+            } else if (arg == "--node-limit") {
+                ok = parse_int(value, opts.node_limit) && opts.node_limit > 0;
+            } else if (arg == "--format") {
+                opts.format = value;
+                ok = value == "csv" || value == "json";
+            } else if (arg == "--out") {
+                opts.output = value;
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                return false;
+            }
+
+            if (!ok) {
+                std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+                return false;
+            }
+        }
+
+        if (opts.cost_high_bound < opts.cost_low_bound) {
+            std::cerr << "Cost higher bound is smaller than lower bound" << std::endl;
+            return false;
+        }
+
+        if (opts.algorithms.empty()) {
+            for (const auto &a : ds::tsp_algorithms) {
+                opts.algorithms.push_back(ds::tsp_algorithm_name(a));
+            }
+        }
+
+        if (opts.sizes.empty() && opts.files.empty()) {
+            std::cerr << "No instances, use --sizes or --files" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    void write_csv(std::ostream &os, const ds::array_list<result> &results) {
+        os << "algo,instance,n,reps,min_us,median_us,p95_us,nodes,cost,gap" << std::endl;
+        for (int i = 0; i < results.size(); ++i) {
+            const auto &r = results[i];
+            os << r.algorithm << "," << r.instance << "," << r.vertices << "," << r.reps << ","
+               << r.min_us << "," << r.median_us << "," << r.p95_us << ","
+               << r.nodes << "," << r.cost << "," << r.gap << std::endl;
+        }
+    }
+
+    void write_json(std::ostream &os, const ds::array_list<result> &results) {
+        os << "[" << std::endl;
+        for (int i = 0; i < results.size(); ++i) {
+            const auto &r = results[i];
+            os << "  {\"algo\": \"" << json_escape(r.algorithm) << "\", "
+               << "\"instance\": \"" << json_escape(r.instance) << "\", "
+               << "\"n\": " << r.vertices << ", "
+               << "\"reps\": " << r.reps << ", "
+               << "\"min_us\": " << r.min_us << ", "
+               << "\"median_us\": " << r.median_us << ", "
+               << "\"p95_us\": " << r.p95_us << ", "
+               << "\"nodes\": " << r.nodes << ", "
+               << "\"cost\": " << r.cost << ", "
+               << "\"gap\": " << r.gap << "}"
+               << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        os << "]" << std::endl;
+    }
+
+    int run(int argc, char **argv) {
+        options opts;
+        if (!parse_options(argc, argv, opts)) {
+            print_usage(std::cerr);
+            return 1;
+        }
+
+        ds::array_list<std::string> names;
+        ds::array_list<ds::undirected_graph> instances;
+
+        for (const auto &n : opts.sizes) {
+            /* each size has its own stream, the instance does not depend on the other sizes */
+            std::mt19937 rng(opts.seed ^ static_cast<unsigned int>(n));
+            names.push_back("random-" + std::to_string(n));
+            instances.push_back(ds::undirected_graph(
+                util::generate_symmetric_cost_matrix(n, opts.cost_low_bound, opts.cost_high_bound, rng)));
+        }
+
+        for (const auto &file : opts.files) {
+            auto matrix = util::read_instance_file(file);
+            if (matrix.size() < 2) {
+                std::cerr << "Invalid cost matrix in " << file << std::endl;
+                return 1;
+            }
+            for (const auto &row : matrix) {
+                if (row.size() != matrix.size()) {
+                    std::cerr << "Cost matrix is not square in " << file << std::endl;
+                    return 1;
+                }
+            }
+            names.push_back(file);
+            instances.push_back(ds::undirected_graph(matrix));
+        }
+
+        ds::array_list<result> results;
+        for (const auto &a : opts.algorithms) {
+            ds::tsp_algorithm algorithm;
+            ds::tsp_algorithm_from_name(a, algorithm);
+            for (int i = 0; i < instances.size(); ++i) {
+                results.push_back(measure(algorithm, names[i], instances[i], opts));
+            }
+        }
+
+        std::ofstream file;
+        if (!opts.output.empty()) {
+            file.open(opts.output);
+            if (!file.is_open()) {
+                std::cerr << "Can't open file " << opts.output << std::endl;
+                return 1;
+            }
+        }
+        std::ostream &os = opts.output.empty() ? std::cout : file;
+
+        if (opts.format == "json") {
+            write_json(os, results);
+        } else {
+            write_csv(os, results);
+        }
+
+        return 0;
+    }
+}
@@ -0,0 +1,237 @@
+#include "json.hpp"
+
+#include <cstdlib>
+#include <cctype>
+#include <string>
+
+namespace json {
+    namespace {
+        class parser {
+        public:
+            parser(const std::string &t_text) : m_text(t_text), m_pos(0) {}
+
+            bool parse_document(value &v, std::string &error) {
+                if (!parse_value(v, 0)) {
+                    error = m_error + " at offset " + std::to_string(m_pos);
+                    return false;
+                }
+                skip_space();
+                if (m_pos != m_text.size()) {
+                    error = "trailing characters at offset " + std::to_string(m_pos);
+                    return false;
+                }
+                return true;
+            }
+
+        private:
+            /* arrays and objects nested deeper than this are rejected, the parser recurses once per level */
+            static constexpr int MAX_DEPTH = 64;
+
+            const std::string &m_text;
+            std::size_t m_pos;
+            std::string m_error;
+
+            bool fail(const std::string &message) {
+                m_error = message;
+                return false;
+            }
+
+            void skip_space() {
+                while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+                    ++m_pos;
+                }
+            }
+
+            bool consume(const char *literal) {
+                std::size_t i = 0;
+                while (literal[i] != '\0') {
+                    if (m_pos + i >= m_text.size() || m_text[m_pos + i] != literal[i]) {
+                        return false;
+                    }
+                    ++i;
+                }
+                m_pos += i;
+                return true;
+            }
+
+            bool parse_value(value &v, int depth) {
+                skip_space();
+                if (m_pos >= m_text.size()) {
+                    return fail("unexpected end of input");
+                }
+
+                char c = m_text[m_pos];
+                if ((c == '{' || c == '[') && depth >= MAX_DEPTH) {
+                    return fail("nesting too deep");
+                }
+                if (c == '{') {
+                    return parse_object(v, depth + 1);
+                } else if (c == '[') {
+                    return parse_array(v, depth + 1);
+                } else if (c == '"') {
+                    v.kind = value::string_kind;
+                    return parse_string(v.string);
+                } else if (consume("true")) {
+                    v.kind = value::bool_kind;
+                    v.boolean = true;
+                    return true;
+                } else if (consume("false")) {
+                    v.kind = value::bool_kind;
+                    v.boolean = false;
+                    return true;
+                } else if (consume("null")) {
+                    v.kind = value::null_kind;
+                    return true;
+                }
+                return parse_number(v);
+            }
+
+            bool parse_number(value &v) {
+                const char *begin = m_text.c_str() + m_pos;
+                char *end;
+                v.number = std::strtod(begin, &end);
+                if (end == begin) {
+                    return fail("unexpected character");
+                }
+                v.kind = value::number_kind;
+                m_pos += end - begin;
+                return true;
+            }
+
+            bool parse_string(std::string &out) {
+                ++m_pos;
+                while (m_pos < m_text.size()) {
+                    char c = m_text[m_pos++];
+                    if (c == '"') {
+                        return true;
+                    }
+                    if (c != '\\') {
+                        out += c;
+                        continue;
+                    }
+                    if (m_pos >= m_text.size()) {
+                        break;
+                    }
+                    char e = m_text[m_pos++];
+                    switch (e) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'r': out += '\r'; break;
+                        case 'b': out += '\b'; break;
+                        case 'f': out += '\f'; break;
+                        case 'u':
+                            /* only the ascii range is decoded, the rest becomes '?' */
+                            if (m_pos + 4 > m_text.size()) {
+                                return fail("invalid escape");
+                            } else {
+                                long code = std::strtol(m_text.substr(m_pos, 4).c_str(), nullptr, 16);
+                                out += code < 0x80 ? static_cast<char>(code) : '?';
+                                m_pos += 4;
+                            }
+                            break;
+                        default: out += e; break;
+                    }
+                }
+                return fail("unterminated string");
+            }
+
+            bool parse_array(value &v, int depth) {
+                v.kind = value::array_kind;
+                ++m_pos;
+                skip_space();
+                if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                    ++m_pos;
+                    return true;
+                }
+                for (;;) {
+                    value element;
+                    if (!parse_value(element, depth)) {
+                        return false;
+                    }
+                    v.array.push_back(element);
+                    skip_space();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                        ++m_pos;
+                    } else if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                        ++m_pos;
+                        return true;
+                    } else {
+                        return fail("expected ',' or ']'");
+                    }
+                }
+            }
+
+            bool parse_object(value &v, int depth) {
+                v.kind = value::object_kind;
+                ++m_pos;
+                skip_space();
+                if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                    ++m_pos;
+                    return true;
+                }
+                for (;;) {
+                    skip_space();
+                    std::string key;
+                    if (m_pos >= m_text.size() || m_text[m_pos] != '"' || !parse_string(key)) {
+                        return fail("expected a key");
+                    }
+                    skip_space();
+                    if (m_pos >= m_text.size() || m_text[m_pos] != ':') {
+                        return fail("expected ':'");
+                    }
+                    ++m_pos;
+
+                    value member;
+                    if (!parse_value(member, depth)) {
+                        return false;
+                    }
+                    v.object.push_back(std::make_pair(key, member));
+
+                    skip_space();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                        ++m_pos;
+                    } else if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                        ++m_pos;
+                        return true;
+                    } else {
+                        return fail("expected ',' or '}'");
+                    }
+                }
+            }
+        };
+    }
+
+    const value* value::find(const std::string &key) const {
+        if (kind != object_kind) {
+            return nullptr;
+        }
+        for (int i = 0; i < object.size(); ++i) {
+            if (object[i].first == key) {
+                return &object[i].second;
+            }
+        }
+        return nullptr;
+    }
+
+    bool parse(const std::string &text, value &v, std::string &error) {
+        parser p(text);
+        return p.parse_document(v, error);
+    }
+
+    std::string quote(const std::string &s) {
+        std::string ret = "\"";
+        for (const auto &c : s) {
+            if (c == '"' || c == '\\') {
+                ret += '\\';
+                ret += c;
+            } else if (c == '\n') {
+                ret += "\\n";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                ret += ' ';
+            } else {
+                ret += c;
+            }
+        }
+        return ret + "\"";
+    }
+}
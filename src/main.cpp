@@ -1,6 +1,23 @@
 #include "menu.hpp"
+#include "bench.hpp"
+#include "batch.hpp"
+#include "serve.hpp"
+
+#include <string>
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "bench") {
+		return bench::run(argc - 2, argv + 2);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "batch") {
+		return batch::run(argc - 2, argv + 2);
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "serve") {
+		return serve::run(argc - 2, argv + 2);
+	}
 
-int main() {
 	menu m;
 	m.start_menu();
 	return 0;
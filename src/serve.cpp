@@ -0,0 +1,400 @@
+#include "serve.hpp"
+#include "json.hpp"
+#include "util.hpp"
+#include "undirected_graph.hpp"
+#include "tsp_solver.hpp"
+#include "tsp_cache.hpp"
+#include "thread_pool.hpp"
+#include "array_list.hpp"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <memory>
+#include <thread>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define SERVE_HAS_UNIX_SOCKET 1
+#endif
+
+namespace serve {
+    namespace {
+        /* The id is echoed back as it was sent, numbers or strings */
+        std::string id_string(const json::value *id) {
+            if (id == nullptr) {
+                return "null";
+            }
+            if (id->is_string()) {
+                return json::quote(id->string);
+            }
+            if (id->is_number()) {
+                /* out of order answers are matched by id, it must not be rounded */
+                if (std::isfinite(id->number) && id->number == std::floor(id->number) && std::fabs(id->number) < 9e18) {
+                    return std::to_string(static_cast<long long>(id->number));
+                }
+                /* the shortest text that reads back as the same double */
+                std::string text;
+                for (int precision = 15; precision <= 17; ++precision) {
+                    std::ostringstream os;
+                    os << std::setprecision(precision) << id->number;
+                    text = os.str();
+                    if (std::strtod(text.c_str(), nullptr) == id->number) {
+                        break;
+                    }
+                }
+                return text;
+            }
+            return "null";
+        }
+
+        std::string error_response(const std::string &id, const std::string &message) {
+            return "{\"id\": " + id + ", \"error\": " + json::quote(message) + "}";
+        }
+
+        bool integer_member(const json::value &request, const char *key, long long &out) {
+            auto v = request.find(key);
+            if (v == nullptr) {
+                return true;
+            }
+            if (!v->is_number() || v->number != std::floor(v->number) || v->number < 0) {
+                return false;
+            }
+            out = static_cast<long long>(v->number);
+            return true;
+        }
+
+        bool integer_cell(const json::value &cell, int &out) {
+            if (!cell.is_number() || !std::isfinite(cell.number) || cell.number != std::floor(cell.number) ||
+                cell.number < std::numeric_limits<int>::min() || cell.number > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            out = static_cast<int>(cell.number);
+            return true;
+        }
+
+        bool read_matrix(const json::value &request, ds::undirected_graph::matrix &matrix, std::string &error) {
+            auto m = request.find("matrix");
+            auto file = request.find("file");
+
+            if (m != nullptr && m->is_array()) {
+                for (int i = 0; i < m->array.size(); ++i) {
+                    const auto &row = m->array[i];
+                    if (!row.is_array()) {
+                        error = "matrix rows must be arrays";
+                        return false;
+                    }
+                    ds::array_list<int> r;
+                    for (int j = 0; j < row.array.size(); ++j) {
+                        int weight;
+                        if (!integer_cell(row.array[j], weight)) {
+                            error = "matrix cells must be integers";
+                            return false;
+                        }
+                        r.push_back(weight);
+                    }
+                    matrix.push_back(r);
+                }
+            } else if (file != nullptr && file->is_string()) {
+                matrix = util::read_instance_file(file->string);
+            } else {
+                error = "request needs a matrix or a file";
+                return false;
+            }
+
+            if (matrix.size() < 2) {
+                error = "cost matrix needs at least 2 vertices";
+                return false;
+            }
+            for (const auto &row : matrix) {
+                if (row.size() != matrix.size()) {
+                    error = "cost matrix is not square";
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /* Solve a parsed request, the answer carries its id */
+        std::string solve_request(const json::value &request, const std::string &id, ds::tsp_cache *cache) {
+            ds::tsp_algorithm algorithm = ds::tsp_algorithm::branch_and_bound;
+            auto algo = request.find("algo");
+            if (algo != nullptr && (!algo->is_string() || !ds::tsp_algorithm_from_name(algo->string, algorithm))) {
+                return error_response(id, "unknown algo");
+            }
+
+            long long start = 0;
+            long long time_limit_ms = 0;
+            long long node_limit = 0;
+            if (!integer_member(request, "start", start) || !integer_member(request, "time_limit_ms", time_limit_ms) ||
+                !integer_member(request, "node_limit", node_limit)) {
+                return error_response(id, "start, time_limit_ms and node_limit must be non-negative integers");
+            }
+
+            ds::undirected_graph::matrix matrix;
+            std::string error;
+            if (!read_matrix(request, matrix, error)) {
+                return error_response(id, error);
+            }
+            if (start >= static_cast<long long>(matrix.size())) {
+                return error_response(id, "start vertex out of range");
+            }
+
+            auto budget = time_limit_ms > 0
+                ? ds::tsp_budget::within(std::chrono::milliseconds(time_limit_ms))
+                : ds::tsp_budget::unlimited();
+            if (node_limit > 0) {
+                budget.node_limit = node_limit;
+            }
+
+            ds::undirected_graph g(matrix);
+            ds::tsp_stats stats;
+            ds::tsp_result result;
+
+            auto key = ds::tsp_cache::key(g, static_cast<int>(start));
+            bool cached = cache != nullptr && cache->find(key, result);
+            if (!cached) {
+                /* the solve already runs on a worker of the daemon, it starts no threads of its own */
+                result = ds::tsp_solve(g, static_cast<int>(start), algorithm, budget, stats, 1);
+                if (cache != nullptr) {
+                    cache->insert(key, result);
+                }
+            }
+
+            std::ostringstream os;
+            os << "{\"id\": " << id
+               << ", \"status\": \"" << ds::tsp_status_name(result.status) << "\""
+               << ", \"cost\": " << result.cost
+               << ", \"lower_bound\": " << result.lower_bound
+               << ", \"gap\": " << result.gap()
+               << ", \"cached\": " << (cached ? "true" : "false")
+               << ", \"tour\": [";
+            for (int i = 0; i < result.tour.size(); ++i) {
+                os << (i > 0 ? ", " : "") << result.tour[i];
+            }
+            os << "], \"time_us\": " << std::chrono::duration<double, std::micro>(stats.total_time).count()
+               << ", \"stats\": {\"generated\": " << stats.nodes_generated
+               << ", \"expanded\": " << stats.nodes_expanded
+               << ", \"pruned\": " << stats.nodes_pruned
+               << ", \"bound_evaluations\": " << stats.bound_evaluations
+               << ", \"max_depth\": " << stats.max_depth
+               << ", \"peak_frontier_bytes\": " << stats.peak_frontier_bytes << "}}";
+            return os.str();
+        }
+
+        /* Write complete lines to a socket, one writer at a time */
+        class connection {
+        public:
+            explicit connection(int t_fd) : m_fd(t_fd) {}
+
+            ~connection() {
+#ifdef SERVE_HAS_UNIX_SOCKET
+                close(m_fd);
+#endif
+            }
+
+            int fd() const {
+                return m_fd;
+            }
+
+            void write_line(const std::string &line) {
+#ifdef SERVE_HAS_UNIX_SOCKET
+                std::lock_guard<std::mutex> lock(m_mutex);
+                std::string data = line + "\n";
+                std::size_t sent = 0;
+                while (sent < data.size()) {
+                    auto n = send(m_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+                    if (n <= 0) {
+                        return;
+                    }
+                    sent += n;
+                }
+#endif
+            }
+
+        private:
+            int m_fd;
+            std::mutex m_mutex;
+        };
+
+        int serve_stdin(ds::thread_pool &pool, ds::tsp_cache *cache) {
+            std::mutex output_mutex;
+            std::string line;
+
+            while (std::getline(std::cin, line)) {
+                if (line.empty()) {
+                    continue;
+                }
+                pool.submit([line, cache, &output_mutex]() {
+                    auto response = handle_request(line, cache);
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    std::cout << response << std::endl;
+                });
+            }
+
+            pool.wait_idle();
+            return 0;
+        }
+
+#ifdef SERVE_HAS_UNIX_SOCKET
+        /* Read request lines of one client, the pool answers them */
+        void serve_client(std::shared_ptr<connection> client, ds::thread_pool &pool, ds::tsp_cache *cache) {
+            char buffer[4096];
+            std::string pending;
+
+            for (;;) {
+                auto n = recv(client->fd(), buffer, sizeof(buffer), 0);
+                if (n <= 0) {
+                    return;
+                }
+                pending.append(buffer, n);
+
+                std::size_t newline;
+                while ((newline = pending.find('\n')) != std::string::npos) {
+                    std::string line = pending.substr(0, newline);
+                    pending.erase(0, newline + 1);
+                    if (line.empty() || line == "\r") {
+                        continue;
+                    }
+                    pool.submit([line, client, cache]() {
+                        client->write_line(handle_request(line, cache));
+                    });
+                }
+            }
+        }
+
+        int serve_socket(const std::string &path, ds::thread_pool &pool, ds::tsp_cache *cache) {
+            sockaddr_un address{};
+            if (path.size() >= sizeof(address.sun_path)) {
+                std::cerr << "Socket path is too long: " << path << std::endl;
+                return 1;
+            }
+
+            int server = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (server < 0) {
+                std::cerr << "Can't create socket" << std::endl;
+                return 1;
+            }
+
+            address.sun_family = AF_UNIX;
+            path.copy(address.sun_path, path.size());
+            unlink(path.c_str());
+
+            if (bind(server, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(server, 64) < 0) {
+                std::cerr << "Can't listen on " << path << std::endl;
+                close(server);
+                return 1;
+            }
+
+            std::cerr << "Listening on " << path << " with " << pool.size() << " workers" << std::endl;
+
+            for (;;) {
+                int fd = accept(server, nullptr, nullptr);
+                if (fd < 0) {
+                    continue;
+                }
+                auto client = std::make_shared<connection>(fd);
+                std::thread([client, &pool, cache]() { serve_client(client, pool, cache); }).detach();
+            }
+        }
+#endif
+
+        bool parse_options(int argc, char **argv, options &opts) {
+            for (int i = 0; i < argc; ++i) {
+                std::string arg = argv[i];
+                if (i + 1 >= argc) {
+                    std::cerr << "Missing value for " << arg << std::endl;
+                    return false;
+                }
+                std::string value = argv[++i];
+
+                if (arg == "--socket") {
+                    opts.socket_path = value;
+                } else if (arg == "--cache-file") {
+                    opts.cache_file = value;
+                } else if (arg == "--cache") {
+                    int size;
+                    try {
+                        size = std::stoi(value);
+                    } catch (const std::exception &) {
+                        size = -1;
+                    }
+                    if (size < 0) {
+                        std::cerr << "Invalid value for --cache: " << value << std::endl;
+                        return false;
+                    }
+                    opts.cache_size = size;
+                } else if (arg == "--jobs") {
+                    try {
+                        opts.jobs = std::stoi(value);
+                    } catch (const std::exception &) {
+                        opts.jobs = -1;
+                    }
+                    if (opts.jobs < 1) {
+                        std::cerr << "Invalid value for --jobs: " << value << std::endl;
+                        return false;
+                    }
+                } else {
+                    std::cerr << "Unknown option: " << arg << std::endl;
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    std::string handle_request(const std::string &line, ds::tsp_cache *cache) {
+        json::value request;
+        std::string error;
+
+        if (!json::parse(line, request, error)) {
+            return error_response("null", "invalid json: " + error);
+        }
+        if (!request.is_object()) {
+            return error_response("null", "request must be an object");
+        }
+
+        auto id = id_string(request.find("id"));
+
+        /* a request that throws, e.g. bad_alloc for a huge instance, is still answered */
+        try {
+            return solve_request(request, id, cache);
+        } catch (const std::exception &e) {
+            return error_response(id, e.what());
+        }
+    }
+
+    int run(int argc, char **argv) {
+        options opts;
+        if (!parse_options(argc, argv, opts)) {
+            std::cerr << "Usage: main serve [--socket PATH] [--jobs N] [--cache N] [--cache-file PATH]" << std::endl;
+            return 1;
+        }
+
+        std::unique_ptr<ds::tsp_cache> cache;
+        if (opts.cache_size > 0) {
+            cache.reset(new ds::tsp_cache(opts.cache_size, opts.cache_file));
+        }
+
+        ds::thread_pool pool(opts.jobs);
+
+        if (opts.socket_path.empty()) {
+            return serve_stdin(pool, cache.get());
+        }
+
+#ifdef SERVE_HAS_UNIX_SOCKET
+        return serve_socket(opts.socket_path, pool, cache.get());
+#else
+        std::cerr << "Unix domain sockets are not available on this platform" << std::endl;
+        return 1;
+#endif
+    }
+}
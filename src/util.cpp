@@ -8,6 +8,8 @@
 #include <sstream>
 #include <chrono>
 #include <random>
+#include <cmath>
+#include <cctype>
 
 namespace util {
     ds::array_list<ds::array_list<int>> read_matrix_from_file(const std::string &file_path) {
@@ -35,6 +37,174 @@ namespace util {
         return matrix;
     }
 
+    namespace {
+        std::string trim(const std::string &s) {
+            auto first = s.find_first_not_of(" \t\r");
+            if (first == std::string::npos) {
+                return "";
+            }
+            auto last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+
+        /* Fill a matrix from the numbers of an EDGE_WEIGHT_SECTION */
+        bool fill_explicit(ds::array_list<ds::array_list<int>> &matrix, const std::string &format, std::istream &in) {
+            int n = matrix.size();
+            auto set = [&matrix](int i, int j, int w) {
+                matrix[i][j] = w;
+                matrix[j][i] = w;
+            };
+
+            int w;
+            if (format == "FULL_MATRIX") {
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        if (!(in >> w)) {
+                            return false;
+                        }
+                        matrix[i][j] = i == j ? 0 : w;
+                    }
+                }
+            } else if (format == "UPPER_ROW" || format == "UPPER_DIAG_ROW") {
+                int offset = format == "UPPER_ROW" ? 1 : 0;
+                for (int i = 0; i < n; ++i) {
+                    for (int j = i + offset; j < n; ++j) {
+                        if (!(in >> w)) {
+                            return false;
+                        }
+                        set(i, j, i == j ? 0 : w);
+                    }
+                }
+            } else if (format == "LOWER_ROW" || format == "LOWER_DIAG_ROW") {
+                int offset = format == "LOWER_ROW" ? 0 : 1;
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < i + offset; ++j) {
+                        if (!(in >> w)) {
+                            return false;
+                        }
+                        set(i, j, i == j ? 0 : w);
+                    }
+                }
+            } else {
+                return false;
+            }
+            return true;
+        }
+
+        /* Distance functions of the TSPLIB specification */
+        bool fill_coordinates(ds::array_list<ds::array_list<int>> &matrix, const std::string &type, std::istream &in) {
+            int n = matrix.size();
+            ds::array_list<double> x(n, 0);
+            ds::array_list<double> y(n, 0);
+
+            for (int k = 0; k < n; ++k) {
+                int id;
+                double a, b;
+                if (!(in >> id >> a >> b) || id < 1 || id > n) {
+                    return false;
+                }
+                x[id - 1] = a;
+                y[id - 1] = b;
+            }
+
+            for (int i = 0; i < n; ++i) {
+                for (int j = i + 1; j < n; ++j) {
+                    double dx = x[i] - x[j];
+                    double dy = y[i] - y[j];
+                    int d;
+                    if (type == "EUC_2D") {
+                        d = static_cast<int>(std::lround(std::sqrt(dx * dx + dy * dy)));
+                    } else if (type == "CEIL_2D") {
+                        d = static_cast<int>(std::ceil(std::sqrt(dx * dx + dy * dy)));
+                    } else if (type == "ATT") {
+                        double r = std::sqrt((dx * dx + dy * dy) / 10.0);
+                        int t = static_cast<int>(std::lround(r));
+                        d = t < r ? t + 1 : t;
+                    } else {
+                        return false;
+                    }
+                    matrix[i][j] = d;
+                    matrix[j][i] = d;
+                }
+            }
+            return true;
+        }
+    }
+
+    ds::array_list<ds::array_list<int>> read_tsplib_file(const std::string &file_path) {
+        std::ifstream file(file_path);
+        ds::array_list<ds::array_list<int>> matrix;
+
+        if (!file.is_open()) {
+            return matrix;
+        }
+
+        int dimension = 0;
+        std::string weight_type;
+        std::string weight_format = "FULL_MATRIX";
+        std::string line;
+
+        while (std::getline(file, line)) {
+            line = trim(line);
+            if (line.empty()) {
+                continue;
+            }
+
+            std::string key = line;
+            std::string value;
+            auto colon = line.find(':');
+            if (colon != std::string::npos) {
+                key = trim(line.substr(0, colon));
+                value = trim(line.substr(colon + 1));
+            }
+
+            if (key == "DIMENSION") {
+                std::istringstream in(value);
+                if (!(in >> dimension) || !(in >> std::ws).eof()) {
+                    return ds::array_list<ds::array_list<int>>();
+                }
+            } else if (key == "EDGE_WEIGHT_TYPE") {
+                weight_type = value;
+            } else if (key == "EDGE_WEIGHT_FORMAT") {
+                weight_format = value;
+            } else if (key == "EDGE_WEIGHT_SECTION" || key == "NODE_COORD_SECTION") {
+                if (dimension < 1) {
+                    return ds::array_list<ds::array_list<int>>();
+                }
+
+                for (int i = 0; i < dimension; ++i) {
+                    matrix.push_back(ds::array_list<int>(dimension, 0));
+                }
+
+                bool ok = key == "EDGE_WEIGHT_SECTION"
+                    ? fill_explicit(matrix, weight_format, file)
+                    : fill_coordinates(matrix, weight_type, file);
+
+                return ok ? matrix : ds::array_list<ds::array_list<int>>();
+            } else if (key == "EOF") {
+                break;
+            }
+        }
+
+        return ds::array_list<ds::array_list<int>>();
+    }
+
+    ds::array_list<ds::array_list<int>> read_instance_file(const std::string &file_path) {
+        std::ifstream file(file_path);
+        std::string first;
+
+        if (!file.is_open()) {
+            return ds::array_list<ds::array_list<int>>();
+        }
+
+        /* a plain matrix starts with a number, TSPLIB with a keyword */
+        file >> first;
+        if (!first.empty() && (std::isdigit(static_cast<unsigned char>(first[0])) || first[0] == '-')) {
+            return read_matrix_from_file(file_path);
+        }
+        return read_tsplib_file(file_path);
+    }
+
     void print_matrix(ds::array_list<ds::array_list<int>> &matrix) {
         for (auto &row : matrix) {
             for (auto &cell : row) {
@@ -85,6 +255,24 @@ namespace util {
         return ret;
     }
 
+    ds::array_list<ds::array_list<int>> generate_symmetric_cost_matrix(int size, int cost_low_bound, int cost_high_bound, std::mt19937 &rng) {
+        ds::array_list<ds::array_list<int>> ret;
+        std::uniform_int_distribution<int> distribute(cost_low_bound, cost_high_bound);
+
+        for (int i = 0; i < size; ++i) {
+            ret.push_back(ds::array_list<int>(size, 0));
+        }
+
+        for (int i = 0; i < size; ++i) {
+            for (int j = i + 1; j < size; ++j) {
+                ret[i][j] = distribute(rng);
+                ret[j][i] = ret[i][j];
+            }
+        }
+
+        return ret;
+    }
+
     int generate_random_num(const int &start, const int &end) {
         std::random_device dev;
         std::mt19937 rgn(dev());
@@ -0,0 +1,73 @@
+#include "batch.hpp"
+#include "json.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+
+namespace fs = std::filesystem;
+
+std::string run_batch(ds::array_list<std::string> args) {
+    auto out = fs::temp_directory_path() / "batch_test_out.txt";
+    args.push_back("--out");
+    args.push_back(out.string());
+
+    ds::array_list<char *> argv;
+    for (auto &a : args) {
+        argv.push_back(&a[0]);
+    }
+    batch::run(static_cast<int>(argv.size()), &argv[0]);
+
+    std::ifstream in(out);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    fs::remove(out);
+    return text;
+}
+
+
+int main() {
+    /* file names with quotes and commas */
+    auto dir = fs::temp_directory_path() / "batch_test";
+    fs::create_directories(dir);
+    auto good = dir / "a\"b,c.txt";
+    auto bad = dir / "x\"y.txt";
+    std::ofstream(good) << "0 4 8 2 3\n4 0 1 6 5\n8 1 0 2 1\n2 6 2 0 6\n3 5 1 6 0\n";
+    std::ofstream(bad) << "0 1\n1\n";
+
+    /* every json line parses back to the file name */
+    auto json_lines = run_batch({"--format", "json", "--jobs", "1", dir.string()});
+    std::size_t lines = 0;
+    std::size_t start = 0;
+    while (start < json_lines.size()) {
+        auto end = json_lines.find('\n', start);
+        json::value v;
+        std::string error;
+        if (!json::parse(json_lines.substr(start, end - start), v, error)) {
+            return 1;
+        }
+        auto file = v.find("file");
+        if (file == nullptr || (file->string != good.string() && file->string != bad.string())) {
+            return 1;
+        }
+        if ((file->string == bad.string()) != (v.find("error") != nullptr)) {
+            return 1;
+        }
+        ++lines;
+        start = end + 1;
+    }
+    if (lines != 2) {
+        return 1;
+    }
+
+    /* csv quotes the fields and doubles the quotes inside */
+    auto csv = run_batch({"--jobs", "1", "--algo", "sa", dir.string()});
+    std::string quoted = "\"" + dir.string() + "/a\"\"b,c.txt\",5,sa,";
+    if (csv.find(quoted) == std::string::npos || csv.find("\"" + dir.string() + "/x\"\"y.txt\",,,") == std::string::npos) {
+        return 1;
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "bench.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+namespace fs = std::filesystem;
+
+int last_status = 0;
+
+/* Run the bench command, returns the report and keeps stdout in captured */
+std::string run_bench(ds::array_list<std::string> args, std::string &captured) {
+    auto out = fs::temp_directory_path() / "bench_test_out.txt";
+    fs::remove(out);
+    args.push_back("--out");
+    args.push_back(out.string());
+
+    ds::array_list<char *> argv;
+    for (auto &a : args) {
+        argv.push_back(&a[0]);
+    }
+    std::ostringstream stdout_text;
+    auto old = std::cout.rdbuf(stdout_text.rdbuf());
+    last_status = bench::run(static_cast<int>(argv.size()), &argv[0]);
+    std::cout.rdbuf(old);
+    captured = stdout_text.str();
+
+    std::ifstream in(out);
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    fs::remove(out);
+    return text;
+}
+
+/* The cost column of the csv row of an instance, empty if there is none */
+std::string cost_of(const std::string &report, const std::string &instance) {
+    std::istringstream lines(report);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream cells(line);
+        std::string cell;
+        ds::array_list<std::string> row;
+        while (std::getline(cells, cell, ',')) {
+            row.push_back(cell);
+        }
+        if (row.size() == 10 && row[1] == instance) {
+            return row[8];
+        }
+    }
+    return "";
+}
+
+
+int main() {
+    std::string captured;
+
+    /* a random instance does not depend on the other sizes of the run */
+    auto alone = run_bench({"--algo", "bnb", "--sizes", "8", "--reps", "1", "--warmup", "0"}, captured);
+    auto range = run_bench({"--algo", "bnb", "--sizes", "6..9", "--reps", "1", "--warmup", "0"}, captured);
+    if (last_status != 0 || cost_of(alone, "random-8").empty() || cost_of(alone, "random-8") != cost_of(range, "random-8")) {
+        return 1;
+    }
+
+    /* TSPLIB files are read like in batch and serve */
+    auto dir = fs::temp_directory_path() / "bench_test";
+    fs::create_directories(dir);
+    auto tsplib = (dir / "five.tsp").string();
+    auto plain = (dir / "five.txt").string();
+    auto ragged = (dir / "ragged.txt").string();
+    std::ofstream(tsplib) << "NAME: five\nTYPE: TSP\nDIMENSION: 5\nEDGE_WEIGHT_TYPE: EXPLICIT\n"
+                             "EDGE_WEIGHT_FORMAT: UPPER_ROW\nEDGE_WEIGHT_SECTION\n4 8 2 3\n1 6 5\n2 1\n6\nEOF\n";
+    std::ofstream(plain) << "0 4 8 2 3\n4 0 1 6 5\n8 1 0 2 1\n2 6 2 0 6\n3 5 1 6 0\n";
+    std::ofstream(ragged) << "0 1 2\n1 0\n2 1 0\n";
+
+    auto files = run_bench({"--algo", "bnb", "--files", tsplib + "," + plain, "--reps", "1", "--warmup", "0"}, captured);
+    if (last_status != 0 || cost_of(files, tsplib).empty() || cost_of(files, tsplib) != cost_of(files, plain)) {
+        return 1;
+    }
+
+    /* bad files fail without a report and without writing to stdout */
+    for (const auto &file : {ragged, (dir / "missing.txt").string()}) {
+        auto report = run_bench({"--algo", "bnb", "--files", file, "--format", "json"}, captured);
+        if (last_status == 0 || !report.empty() || !captured.empty()) {
+            return 1;
+        }
+    }
+
+    fs::remove_all(dir);
+    return 0;
+}
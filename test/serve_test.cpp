@@ -0,0 +1,104 @@
+#include "json.hpp"
+#include "serve.hpp"
+
+#include <string>
+
+
+bool contains(const std::string &text, const std::string &part) {
+    return text.find(part) != std::string::npos;
+}
+
+bool rejects(const std::string &text) {
+    json::value v;
+    std::string error;
+    return !json::parse(text, v, error) && !error.empty();
+}
+
+
+int main() {
+    /* malformed documents */
+    for (const char *text : {"", "{", "[1,", "[1 2]", "{\"a\" 1}", "{\"a\": 1,}", "{1: 2}", "tru", "\"open", "1 2", "\"\\u00\""}) {
+        if (!rejects(text)) {
+            return 1;
+        }
+    }
+
+    /* nesting is limited, a long run of brackets is an error and not a crash */
+    json::value v;
+    std::string error;
+    if (!json::parse(std::string(64, '[') + std::string(64, ']'), v, error)) {
+        return 1;
+    }
+    if (json::parse(std::string(65, '[') + std::string(65, ']'), v, error) || !contains(error, "nesting too deep")) {
+        return 1;
+    }
+    if (json::parse(std::string(200000, '['), v, error) || !contains(error, "nesting too deep")) {
+        return 1;
+    }
+    if (json::parse(std::string(100, '{'), v, error)) {
+        return 1;
+    }
+
+    /* escapes are decoded and quoted back */
+    if (!json::parse("{\"s\": \"a\\\"b\\\\c\\n\\u0041\", \"n\": [1.5, -2, true, null]}", v, error)) {
+        return 1;
+    }
+    auto s = v.find("s");
+    auto n = v.find("n");
+    if (s == nullptr || !s->is_string() || s->string != "a\"b\\c\nA" || n == nullptr || n->array.size() != 4 ||
+        n->array[0].number != 1.5 || n->array[1].number != -2 || v.find("missing") != nullptr) {
+        return 1;
+    }
+    if (json::quote(s->string) != "\"a\\\"b\\\\c\\nA\"") {
+        return 1;
+    }
+
+    /* a plain solve */
+    auto response = serve::handle_request(
+        "{\"id\": 7, \"algo\": \"bnb\", \"matrix\": [[0, 1, 2, 3], [1, 0, 4, 5], [2, 4, 0, 6], [3, 5, 6, 0]]}", nullptr);
+    if (!contains(response, "\"id\": 7") || !contains(response, "\"status\": \"optimal\"") ||
+        !contains(response, "\"cost\": 14") || contains(response, "error")) {
+        return 1;
+    }
+
+    /* the heuristics run on the calling worker */
+    for (const char *algo : {"aco", "sa", "cluster"}) {
+        auto heuristic = serve::handle_request(std::string("{\"id\": 8, \"algo\": \"") + algo +
+            "\", \"matrix\": [[0, 1, 2, 3, 4], [1, 0, 4, 5, 6], [2, 4, 0, 6, 7], [3, 5, 6, 0, 8], [4, 6, 7, 8, 0]]}", nullptr);
+        if (!contains(heuristic, "\"id\": 8") || contains(heuristic, "error")) {
+            return 1;
+        }
+    }
+
+    /* ids come back exactly as they were sent */
+    for (const char *id : {"1234567", "1234568", "-3", "0.1", "2.5e-07", "\"a\\\"b\""}) {
+        auto echoed = serve::handle_request(std::string("{\"id\": ") + id + ", \"matrix\": [[0, 1], [1, 0]]}", nullptr);
+        if (!contains(echoed, std::string("{\"id\": ") + id + ",")) {
+            return 1;
+        }
+    }
+
+    /* cells must be integers that fit an int */
+    for (const char *cell : {"1.5", "1e12", "-1e12", "\"1\"", "true"}) {
+        auto rejected = serve::handle_request(std::string("{\"id\": 2, \"matrix\": [[0, ") + cell + "], [1, 0]]}", nullptr);
+        if (!contains(rejected, "\"error\": \"matrix cells must be integers\"")) {
+            return 1;
+        }
+    }
+
+    /* bad requests are answered with an error */
+    if (!contains(serve::handle_request(std::string(200000, '['), nullptr), "nesting too deep")) {
+        return 1;
+    }
+    if (!contains(serve::handle_request("{\"id\": \"x\", \"matrix\": [[0, 1], [1]]}", nullptr), "\"error\": \"cost matrix is not square\"")) {
+        return 1;
+    }
+    if (!contains(serve::handle_request("{\"id\": 1, \"algo\": \"nope\", \"matrix\": [[0, 1], [1, 0]]}", nullptr), "unknown algo")) {
+        return 1;
+    }
+    if (!contains(serve::handle_request("[1, 2]", nullptr), "request must be an object")) {
+        return 1;
+    }
+
+    return 0;
+}
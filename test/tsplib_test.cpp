@@ -0,0 +1,79 @@
+#include "util.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+
+namespace fs = std::filesystem;
+
+typedef ds::array_list<ds::array_list<int>> matrix;
+
+matrix read(const std::string &text, bool plain = false) {
+    auto path = fs::temp_directory_path() / "tsplib_test.tsp";
+    std::ofstream(path) << text;
+    auto m = plain ? util::read_instance_file(path.string()) : util::read_tsplib_file(path.string());
+    fs::remove(path);
+    return m;
+}
+
+bool equal(const matrix &m, const matrix &expected) {
+    if (m.size() != expected.size()) {
+        return false;
+    }
+    for (int i = 0; i < m.size(); ++i) {
+        for (int j = 0; j < m.size(); ++j) {
+            if (m[i][j] != expected[i][j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+int main() {
+    matrix three = {{0, 1, 2}, {1, 0, 3}, {2, 3, 0}};
+
+    /* explicit weights in every layout give the same matrix */
+    const char *full = "NAME: t\nTYPE: TSP\nDIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                       "EDGE_WEIGHT_SECTION\n0 1 2\n1 0 3\n2 3 0\nEOF\n";
+    const char *upper = "DIMENSION : 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: UPPER_ROW\nEDGE_WEIGHT_SECTION\n1 2\n3\nEOF\n";
+    const char *lower = "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: LOWER_DIAG_ROW\n"
+                        "EDGE_WEIGHT_SECTION\n0\n1 0\n2 3 0\nEOF\n";
+    if (!equal(read(full), three) || !equal(read(upper), three) || !equal(read(lower), three)) {
+        return 1;
+    }
+
+    /* EUC_2D rounds to the nearest integer */
+    const char *euc = "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n2 3 4\n3 1.5 0\nEOF\n";
+    if (!equal(read(euc), {{0, 5, 2}, {5, 0, 4}, {2, 4, 0}})) {
+        return 1;
+    }
+
+    /* ATT rounds the pseudo euclidean distance up unless it is exact */
+    const char *att = "DIMENSION: 3\nEDGE_WEIGHT_TYPE: ATT\nNODE_COORD_SECTION\n1 0 0\n2 10 0\n3 3 9\nEOF\n";
+    if (!equal(read(att), {{0, 4, 3}, {4, 0, 4}, {3, 4, 0}})) {
+        return 1;
+    }
+
+    /* a truncated section or a bad header gives an empty matrix */
+    const char *truncated = "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EXPLICIT\nEDGE_WEIGHT_FORMAT: FULL_MATRIX\n"
+                            "EDGE_WEIGHT_SECTION\n0 1 2\n1 0\n";
+    const char *coordinates = "DIMENSION: 3\nEDGE_WEIGHT_TYPE: EUC_2D\nNODE_COORD_SECTION\n1 0 0\n2 3 4\n";
+    for (const char *text : {truncated, coordinates, "DIMENSION: abc\nEDGE_WEIGHT_SECTION\n0\n",
+                             "DIMENSION: 3x\nEDGE_WEIGHT_SECTION\n0 1 2\n1 0 3\n2 3 0\n",
+                             "DIMENSION: 99999999999999\nEDGE_WEIGHT_SECTION\n0\n", "DIMENSION: 0\nEDGE_WEIGHT_SECTION\n",
+                             "DIMENSION: 2\nEDGE_WEIGHT_TYPE: GEO\nNODE_COORD_SECTION\n1 0 0\n2 1 1\n"}) {
+        if (read(text).size() != 0) {
+            return 1;
+        }
+    }
+
+    /* read_instance_file tells a plain matrix from TSPLIB */
+    if (!equal(read("0 1 2\n1 0 3\n2 3 0\n", true), three) || !equal(read(full, true), three)) {
+        return 1;
+    }
+
+    return 0;
+}